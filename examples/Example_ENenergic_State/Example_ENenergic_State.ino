@@ -0,0 +1,78 @@
+/***********************************************************************
+ * Project      :     Example_ENenergic_State
+ * Description  :     Read full state of ENenergic Power Meter in 2 FC03
+ *                    request (ENenergic_readState), compute power of each
+ *                    phase and voltage unbalance from phasor every cycle
+ * Hardware     :     tiny32_v3
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17/10/2026
+ * Revision     :     1.0
+ * Rev1.0       :     Origital
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     +66 89-140-7205
+ ***********************************************************************/
+#include <Arduino.h>
+#include <tiny32_v3.h>
+
+/**************************************/
+/*        define object variable      */
+/**************************************/
+tiny32_v3 mcu;
+
+/**************************************/
+/*        define global variable      */
+/**************************************/
+uint8_t id = 1;              // ENenergic address
+tiny32_ENenergicState meter; // state (getters use copy of the last read)
+
+/***********************************************************************
+ * FUNCTION:    setup
+ * DESCRIPTION: setup process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void setup()
+{
+  Serial.begin(115200);
+  mcu.ENenergic_begin(RXD2, TXD2);
+  Serial.printf("*** Example_ENenergic_State ***\r\n");
+  mcu.library_version();
+}
+
+/***********************************************************************
+ * FUNCTION:    loop
+ * DESCRIPTION: loop process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void loop()
+{
+  uint32_t _start = millis();
+
+  if (!mcu.ENenergic_readState(id, meter))
+  {
+    Serial.printf("Error: ENenergic is not answer\r\n");
+    vTaskDelay(1000);
+    return;
+  }
+  Serial.printf("Info: state %d mS\r\n", (int)(millis() - _start));
+
+  float _v_avg = 0, _v_dev = 0;
+  for (uint8_t _i = 0; _i < 3; _i++)
+  {
+    tiny32_Phasor &_v = meter.volt[_i];
+    tiny32_Phasor &_c = meter.current[_i];
+    float _watt = _v.magnitude * _c.magnitude * cosf((_v.angle - _c.angle) * DEG_TO_RAD);
+
+    Serial.printf("Info: L%d %7.1f V <%7.1f  %7.2f A <%7.1f  %8.1f W\r\n", _i + 1, _v.magnitude, _v.angle, _c.magnitude, _c.angle, _watt);
+    _v_avg += _v.magnitude / 3;
+  }
+  for (uint8_t _i = 0; _i < 3; _i++)
+    _v_dev = max(_v_dev, fabsf(meter.volt[_i].magnitude - _v_avg));
+
+  Serial.printf("Info: L-L %.1f %.1f %.1f V, N %.2f A, %.2f Hz, %.1f C\r\n", meter.volt_LL[0], meter.volt_LL[1], meter.volt_LL[2], meter.neutral_current, meter.freq, meter.temperature);
+  Serial.printf("Info: voltage unbalance %.2f %%\r\n", (_v_avg > 0) ? (_v_dev * 100 / _v_avg) : 0);
+  Serial.printf("*****************************\r\n");
+  vTaskDelay(1000);
+}
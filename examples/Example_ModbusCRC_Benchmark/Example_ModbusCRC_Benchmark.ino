@@ -0,0 +1,97 @@
+/***********************************************************************
+ * Project      :     Example_ModbusCRC_Benchmark
+ * Description  :     Compare CRC16 bit by bit (crc16_update) with CRC16 table
+ *                    (crc16) and cached request CRC16 on ModbusRTU frames
+ * Hardware     :     tiny32_v3
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17/10/2026
+ * Revision     :     1.0
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     +66 89-140-7205
+ ***********************************************************************/
+#include <tiny32_v3.h>
+
+tiny32_v3 mcu; //define object
+HardwareSerial bench_port(2);
+tiny32_ModbusMaster bench(bench_port);
+
+#define LOOP 10000
+
+uint8_t frame[50];
+const uint8_t frame_size[] = {8, 13, 25, 50}; // request, 4 register, 10 register (PZEM-016), 22 register response
+
+uint16_t crc_bitwise(const uint8_t *data, uint16_t len)
+{
+  uint16_t _crc = 0xffff;
+  for (uint16_t _i = 0; _i < len; _i++)
+    _crc = tiny32_ModbusMaster::crc16_update(_crc, data[_i]);
+  return _crc;
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.printf("\r\n**** Example_ModbusCRC_Benchmark ****\r\n");
+  mcu.library_version();
+
+  for (uint8_t i = 0; i < sizeof(frame); i++)
+    frame[i] = random(256);
+}
+
+void loop()
+{
+  volatile uint16_t sink = 0;
+  uint32_t t_start;
+  uint32_t t_bitwise;
+  uint32_t t_table;
+  uint32_t t_cached;
+
+  Serial.printf("\r\nsize   bitwise[nS]   table[nS]   speed up\r\n");
+  for (uint8_t i = 0; i < sizeof(frame_size); i++)
+  {
+    uint8_t len = frame_size[i];
+
+    if (crc_bitwise(frame, len) != tiny32_ModbusMaster::crc16(frame, len))
+      Serial.printf("Error: crc16 table is not equal to crc16_update\r\n");
+
+    t_start = micros();
+    for (uint16_t n = 0; n < LOOP; n++)
+    {
+      frame[0] = n;
+      sink ^= crc_bitwise(frame, len);
+    }
+    t_bitwise = micros() - t_start;
+
+    t_start = micros();
+    for (uint16_t n = 0; n < LOOP; n++)
+    {
+      frame[0] = n;
+      sink ^= tiny32_ModbusMaster::crc16(frame, len);
+    }
+    t_table = micros() - t_start;
+
+    Serial.printf("%4d   %11.1f   %9.1f   x%.1f\r\n", len, t_bitwise * 1000.0 / LOOP, t_table * 1000.0 / LOOP, (float)t_bitwise / t_table);
+  }
+
+  /*** request frame of PZEM-016 [id 04 00 00 00 0A crcL crcH] for id 1..8 ***/
+  uint8_t request[8];
+  t_start = micros();
+  for (uint16_t n = 0; n < LOOP; n++)
+  {
+    tiny32_ModbusMaster::request(request, (n & 7) + 1, 0x04, 0x0000, 10);
+    sink ^= request[6];
+  }
+  t_table = micros() - t_start;
+
+  t_start = micros();
+  for (uint16_t n = 0; n < LOOP; n++)
+  {
+    bench.cachedRequest(request, (n & 7) + 1, 0x04, 0x0000, 10);
+    sink ^= request[6];
+  }
+  t_cached = micros() - t_start;
+
+  Serial.printf("request build[nS]: crc16 = %.1f, cached crc16 = %.1f\r\n", t_table * 1000.0 / LOOP, t_cached * 1000.0 / LOOP);
+  vTaskDelay(5000);
+}
@@ -0,0 +1,88 @@
+/***********************************************************************
+ * Project      :     Example_ModbusCapture
+ * Description  :     Capture ModbusRTU frame at runtime without debug print
+ *                    SW1 = start/ stop capture, SW2 = drain capture as
+ *                    "CAPTURE:<hex>" line (convert with extra/modbus_capture.py)
+ *                    or as text when TEXT_OUTPUT is defined
+ * Hardware     :     tiny32_v3
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17/10/2026
+ * Revision     :     1.0
+ * Rev1.0       :     Origital
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     +66 89-140-7205
+ ***********************************************************************/
+#include <Arduino.h>
+#include <tiny32_v3.h>
+
+// #define TEXT_OUTPUT
+
+/**************************************/
+/*        define object variable      */
+/**************************************/
+tiny32_v3 mcu;
+
+/**************************************/
+/*        define global variable      */
+/**************************************/
+uint8_t id = 1;          // PZEM-016 address
+uint8_t stream[1024];    // binary stream of drain()
+
+/***********************************************************************
+ * FUNCTION:    setup
+ * DESCRIPTION: setup process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void setup()
+{
+  Serial.begin(115200);
+  mcu.PZEM_016_begin(RXD2, TXD2);
+  Serial.printf("*** Example_ModbusCapture ***\r\n");
+  mcu.library_version();
+}
+
+/***********************************************************************
+ * FUNCTION:    loop
+ * DESCRIPTION: loop process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void loop()
+{
+  float volt, amp, power, freq, pf;
+  uint32_t energy;
+
+  mcu.PZEM_016(id, volt, amp, power, energy, freq, pf);
+
+  if (mcu.Sw1())
+  {
+    modbus_capture.enable(!modbus_capture.enabled());
+    mcu.RedLED(modbus_capture.enabled());
+    Serial.printf("Info: capture %s\r\n", modbus_capture.enabled() ? "start" : "stop");
+    while (mcu.Sw1())
+      vTaskDelay(10);
+  }
+
+  if (mcu.Sw2())
+  {
+#ifdef TEXT_OUTPUT
+    modbus_capture.printCapture();
+#else
+    uint16_t _len;
+    while ((_len = modbus_capture.drain(stream, sizeof(stream))) > 0)
+    {
+      Serial.printf("CAPTURE:");
+      for (uint16_t _i = 0; _i < _len; _i++)
+        Serial.printf("%02X", stream[_i]);
+      Serial.printf("\r\n");
+    }
+    Serial.printf("Info: lost frame = %u\r\n", modbus_capture.lost());
+#endif
+    while (mcu.Sw2())
+      vTaskDelay(10);
+  }
+
+  vTaskDelay(200);
+}
@@ -0,0 +1,85 @@
+/***********************************************************************
+ * Project      :     Example_ModbusDeviceMap
+ * Description  :     Read all register of Chiller R717 with declarative
+ *                    register map (4 block read instead of 25 request) and
+ *                    add own device as one register list
+ * Hardware     :     tiny32_v3
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17/10/2026
+ * Revision     :     1.0
+ * Rev1.0       :     Origital
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     +66 89-140-7205
+ ***********************************************************************/
+#include <Arduino.h>
+#include <tiny32_v3.h>
+
+/**************************************/
+/*        own device register map     */
+/**************************************/
+/*  name,       function, address, format,        scale */
+#define MY_METER_REGISTER(X)                             \
+    X(VOLT,     0x04, 0x0000, MODBUS_UINT16,      0.1)   \
+    X(CURRENT,  0x04, 0x0001, MODBUS_UINT32_CDAB, 0.001) \
+    X(POWER,    0x04, 0x0003, MODBUS_UINT32_CDAB, 0.1)   \
+    X(FREQ,     0x04, 0x0007, MODBUS_UINT16,      0.1)
+
+MODBUS_DEVICE_MAP(MY_METER, MY_METER_REGISTER);
+
+/**************************************/
+/*        define object variable      */
+/**************************************/
+tiny32_v3 mcu;
+
+/**************************************/
+/*        define global variable      */
+/**************************************/
+uint8_t chiller_id = 1;
+uint8_t meter_id = 2;
+tiny32_CHILLER_R717 chiller;
+tiny32_MY_METER meter;
+
+/***********************************************************************
+ * FUNCTION:    setup
+ * DESCRIPTION: setup process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void setup()
+{
+  Serial.begin(115200);
+  mcu.CHILLER_R717_begin(RXD2, TXD2);
+  Serial.printf("*** Example_ModbusDeviceMap ***\r\n");
+  mcu.library_version();
+  tiny32_CHILLER_R717_map.printMap();
+  tiny32_MY_METER_map.printMap();
+}
+
+/***********************************************************************
+ * FUNCTION:    loop
+ * DESCRIPTION: loop process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void loop()
+{
+  uint32_t _start = millis();
+
+  tiny32_CHILLER_R717_map.read(modbus_rs485, chiller_id, chiller);
+  Serial.printf("Info: Chiller read %d mS\r\n", (int)(millis() - _start));
+  for (uint8_t _i = 0; _i < tiny32_CHILLER_R717::FIELD_COUNT; _i++)
+  {
+    if (chiller.isValid(_i))
+      Serial.printf("Info: %-20s => %.1f\r\n", tiny32_CHILLER_R717_map.reg(_i)->name, chiller.value[_i]);
+    else
+      Serial.printf("Info: %-20s => --\r\n", tiny32_CHILLER_R717_map.reg(_i)->name);
+  }
+  Serial.printf("Info: Total power => %.1f kW\r\n", chiller.TOTAL_KW());
+
+  if (tiny32_MY_METER_map.read(modbus_rs485, meter_id, meter))
+    Serial.printf("Info: Meter %.1f V, %.3f A, %.1f W, %.1f Hz\r\n", meter.VOLT(), meter.CURRENT(), meter.POWER(), meter.FREQ());
+
+  Serial.printf("*****************************\r\n");
+  vTaskDelay(1000);
+}
@@ -0,0 +1,94 @@
+/***********************************************************************
+ * Project      :     Example_ModbusPlanner
+ * Description  :     Read all SDM630MCT value and CHILLER R717 temperature
+ *                    with few block read instead of one read per value
+ * Hardware     :     tiny32_v3
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17/10/2026
+ * Revision     :     1.0
+ * Rev1.0       :     Origital
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     +66 89-140-7205
+ ***********************************************************************/
+#include <Arduino.h>
+#include <tiny32_v3.h>
+
+/**************************************/
+/*        define object variable      */
+/**************************************/
+tiny32_v3 mcu;
+tiny32_ModbusPlanner planner(16); // max gap 16 register, max 125 register per read
+
+/**************************************/
+/*        define global variable      */
+/**************************************/
+uint8_t sdm630_id = 1;
+uint8_t chiller_id = 2;
+
+float volt[3], current[3], watt[3], va[3], var[3], pf[3];
+float freq, sum_current, total_watt, total_va, total_var;
+float chilled_in, chilled_out, cooled_in, cooled_out, room_temp, comp_current, comp_power;
+float hour_chilled_pump, hour_comp;
+
+/***********************************************************************
+ * FUNCTION:    setup
+ * DESCRIPTION: setup process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void setup()
+{
+  Serial.begin(115200);
+  mcu.SDM630MCT_begin(RXD2, TXD2);
+  Serial.printf("*** Example_ModbusPlanner ***\r\n");
+  mcu.library_version();
+
+  /*** SDM630MCT: 25 value, register 0x00-0x47 => 1 read ***/
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    planner.add(sdm630_id, 0x04, 0x0000 + i * 2, MODBUS_FLOAT, &volt[i]);
+    planner.add(sdm630_id, 0x04, 0x0006 + i * 2, MODBUS_FLOAT, &current[i]);
+    planner.add(sdm630_id, 0x04, 0x000C + i * 2, MODBUS_FLOAT, &watt[i]);
+    planner.add(sdm630_id, 0x04, 0x0012 + i * 2, MODBUS_FLOAT, &va[i]);
+    planner.add(sdm630_id, 0x04, 0x0018 + i * 2, MODBUS_FLOAT, &var[i]);
+    planner.add(sdm630_id, 0x04, 0x001E + i * 2, MODBUS_FLOAT, &pf[i]);
+  }
+  planner.add(sdm630_id, 0x04, 0x0030, MODBUS_FLOAT, &sum_current);
+  planner.add(sdm630_id, 0x04, 0x0034, MODBUS_FLOAT, &total_watt);
+  planner.add(sdm630_id, 0x04, 0x0038, MODBUS_FLOAT, &total_va);
+  planner.add(sdm630_id, 0x04, 0x003C, MODBUS_FLOAT, &total_var);
+  planner.add(sdm630_id, 0x04, 0x0046, MODBUS_FLOAT, &freq);
+
+  /*** CHILLER R717: int16 x 0.1, register 0x01-0x17 and 0x9D-0x9E => 2 read ***/
+  planner.add(chiller_id, 0x04, 0x0001, MODBUS_INT16, &chilled_in, 0.1);
+  planner.add(chiller_id, 0x04, 0x0002, MODBUS_INT16, &chilled_out, 0.1);
+  planner.add(chiller_id, 0x04, 0x0003, MODBUS_INT16, &cooled_in, 0.1);
+  planner.add(chiller_id, 0x04, 0x0004, MODBUS_INT16, &cooled_out, 0.1);
+  planner.add(chiller_id, 0x04, 0x0010, MODBUS_INT16, &room_temp, 0.1);
+  planner.add(chiller_id, 0x04, 0x0014, MODBUS_INT16, &comp_current, 0.1);
+  planner.add(chiller_id, 0x04, 0x0017, MODBUS_INT16, &comp_power, 0.1);
+  planner.add(chiller_id, 0x04, 0x009D, MODBUS_INT16, &hour_chilled_pump, 0.1);
+  planner.add(chiller_id, 0x04, 0x009E, MODBUS_INT16, &hour_comp, 0.1);
+
+  planner.printPlan();
+}
+
+/***********************************************************************
+ * FUNCTION:    loop
+ * DESCRIPTION: loop process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void loop()
+{
+  uint32_t t_start = millis();
+  bool success = planner.read(modbus_rs485);
+
+  Serial.printf("\r\nread %s in %d mS\r\n", success ? "success" : "fail", millis() - t_start);
+  Serial.printf("SDM630MCT: %.1f/%.1f/%.1f V, %.2f/%.2f/%.2f A, total %.1f W, %.2f Hz\r\n",
+                volt[0], volt[1], volt[2], current[0], current[1], current[2], total_watt, freq);
+  Serial.printf("CHILLER: chilled %.1f/%.1f C, cooled %.1f/%.1f C, room %.1f C, comp %.1f A %.1f kW\r\n",
+                chilled_in, chilled_out, cooled_in, cooled_out, room_temp, comp_current, comp_power);
+  vTaskDelay(5000);
+}
@@ -0,0 +1,77 @@
+/***********************************************************************
+ * Project      :     Example_ModbusRTU_Async
+ * Description  :     Read PZEM-016 with bus task (core 0) while loop() keep
+ *                    blink LED and read switch without waiting for RS485
+ * Hardware     :     tiny32_v3
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17/10/2026
+ * Revision     :     1.0
+ * Rev1.0       :     Origital
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     +66 89-140-7205
+ ***********************************************************************/
+#include <Arduino.h>
+#include <tiny32_v3.h>
+
+/**************************************/
+/*        define object variable      */
+/**************************************/
+tiny32_v3 mcu;
+tiny32_ModbusJob job;
+
+/**************************************/
+/*        define global variable      */
+/**************************************/
+uint8_t id = 1;     // PZEM-016 address
+uint8_t data[20];   // 10 register
+bool led = false;
+
+/***********************************************************************
+ * FUNCTION:    pzem_done
+ * DESCRIPTION: callback from bus task when PZEM-016 job finish
+ * PARAMETERS:  job
+ * RETURNED:    nothing
+ ***********************************************************************/
+void pzem_done(tiny32_ModbusJob *job)
+{
+  if (job->success())
+    Serial.printf("Info: PZEM-016 volt = %.1f V\r\n", tiny32_ModbusMaster::toUint16(&data[0]) * 0.1);
+  else
+    Serial.printf("Error: PZEM-016 id %d not response\r\n", job->id);
+}
+
+/***********************************************************************
+ * FUNCTION:    setup
+ * DESCRIPTION: setup process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void setup()
+{
+  Serial.begin(115200);
+  mcu.PZEM_016_begin(RXD2, TXD2);
+  mcu.modbusRTU_beginTask(2, 0); // bus task on core 0, loop() run on core 1
+  Serial.printf("*** Example_ModbusRTU_Async ***\r\n");
+  mcu.library_version();
+}
+
+/***********************************************************************
+ * FUNCTION:    loop
+ * DESCRIPTION: loop process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void loop()
+{
+  /*** 1) callback : queue the job and keep going ***/
+  if (job.status != MODBUS_JOB_PENDING)
+    modbus_rs485.readAsync(&job, id, 0x04, 0x0000, 10, data, pzem_done);
+
+  /*** 2) blocking function still work, it wait on the bus task ***/
+  if (mcu.Sw1())
+    Serial.printf("Info: PZEM-016 power = %.1f W\r\n", mcu.PZEM_016_Power(id));
+
+  mcu.BlueLED(led = !led);
+  vTaskDelay(100);
+}
@@ -0,0 +1,174 @@
+/***********************************************************************
+ * Project      :     Example_ModbusResync_Benchmark
+ * Description  :     Replay benchmark of response frame recovery, the same
+ *                    PZEM-016 response is replayed with line noise, local
+ *                    echo of request and leftover byte before/ after it.
+ *                    Compare the old receive (skip 0x00/0xFF, keep the last
+ *                    N byte) with tiny32_ModbusMaster::findFrame (CRC16
+ *                    sliding window), no RS485 hardware is needed
+ * Hardware     :     tiny32_v3
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17/10/2026
+ * Revision     :     1.0
+ * Rev1.0       :     Origital
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     +66 89-140-7205
+ ***********************************************************************/
+#include <Arduino.h>
+#include <tiny32_v3.h>
+
+/**************************************/
+/*        define global variable      */
+/**************************************/
+#define REPLAY_COUNT 2000 // stream of each case
+#define RESPONSE_LEN 25   // PZEM-016, 10 register
+
+uint8_t request[8];
+uint8_t response[RESPONSE_LEN];
+uint8_t stream[MODBUS_FRAME_MAX];
+
+const char *case_name[] = {"clean", "noise before", "noise after", "echo before", "noise before + after", "bit error (must fail)"};
+#define CASE_COUNT (sizeof(case_name) / sizeof(case_name[0]))
+
+/***********************************************************************
+ * FUNCTION:    noise
+ * DESCRIPTION: Random byte, often the id/function to make false header
+ * PARAMETERS:  data, len
+ * RETURNED:    nothing
+ ***********************************************************************/
+void noise(uint8_t *data, uint8_t len)
+{
+  for (uint8_t _i = 0; _i < len; _i++)
+  {
+    uint8_t _r = random(4);
+    data[_i] = (_r == 0) ? request[0] : (_r == 1) ? request[1] : random(256);
+  }
+}
+
+/***********************************************************************
+ * FUNCTION:    makeStream
+ * DESCRIPTION: Replay stream of one case
+ * PARAMETERS:  case
+ * RETURNED:    length of stream
+ ***********************************************************************/
+uint16_t makeStream(uint8_t replay_case)
+{
+  uint16_t _len = 0;
+  uint8_t _before = 1 + random(8);
+  uint8_t _after = 1 + random(8);
+
+  if ((replay_case == 1) || (replay_case == 4))
+  {
+    noise(&stream[_len], _before);
+    _len += _before;
+  }
+  if (replay_case == 3)
+  {
+    memcpy(&stream[_len], request, sizeof(request));
+    _len += sizeof(request);
+  }
+
+  memcpy(&stream[_len], response, RESPONSE_LEN);
+  if (replay_case == 5)
+    stream[_len + 3 + random(RESPONSE_LEN - 3)] ^= 1 << random(8);
+  _len += RESPONSE_LEN;
+
+  if ((replay_case == 2) || (replay_case == 4))
+  {
+    noise(&stream[_len], _after);
+    _len += _after;
+  }
+
+  return _len;
+}
+
+/***********************************************************************
+ * FUNCTION:    oldReceive
+ * DESCRIPTION: Receive of library before Rev3.27 (skip leading 0x00/0xFF,
+ *              keep the last N byte, check CRC16)
+ * PARAMETERS:  data, len
+ * RETURNED:    true = frame recovered
+ ***********************************************************************/
+bool oldReceive(const uint8_t *data, uint16_t len)
+{
+  uint16_t _start = 0;
+
+  while ((_start < len) && ((data[_start] == 0x00) || (data[_start] == 0xFF)))
+    _start++;
+
+  if (len - _start < RESPONSE_LEN)
+    return false;
+
+  const uint8_t *_frame = &data[len - RESPONSE_LEN];
+  return tiny32_ModbusMaster::crc16(_frame, RESPONSE_LEN) == 0;
+}
+
+/***********************************************************************
+ * FUNCTION:    newReceive
+ * DESCRIPTION: findFrame is called for each byte (as byte arrive)
+ * PARAMETERS:  data, len
+ * RETURNED:    true = frame recovered
+ ***********************************************************************/
+bool newReceive(const uint8_t *data, uint16_t len)
+{
+  uint16_t _scan = 0;
+  uint16_t _frame_len;
+
+  for (uint16_t _n = 2; _n <= len; _n++)
+  {
+    int16_t _frame = tiny32_ModbusMaster::findFrame(data, _n, request, RESPONSE_LEN, &_scan, &_frame_len);
+    if (_frame >= 0)
+      return memcmp(&data[_frame], response, RESPONSE_LEN) == 0;
+  }
+
+  return false;
+}
+
+/***********************************************************************
+ * FUNCTION:    setup
+ * DESCRIPTION: setup process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void setup()
+{
+  Serial.begin(115200);
+  Serial.printf("*** Example_ModbusResync_Benchmark ***\r\n");
+
+  /*** PZEM-016 read 10 input register and its response ***/
+  tiny32_ModbusMaster::request(request, 0x01, 0x04, 0x0000, 10);
+  response[0] = 0x01;
+  response[1] = 0x04;
+  response[2] = 20;
+  for (uint8_t _i = 0; _i < 20; _i++)
+    response[3 + _i] = random(256);
+  tiny32_ModbusMaster::appendCRC(response, RESPONSE_LEN - 2);
+
+  Serial.printf("\r\n case                    old recover   new recover   new[uS/stream]\r\n");
+  for (uint8_t _c = 0; _c < CASE_COUNT; _c++)
+  {
+    uint32_t _old = 0, _new = 0, _time = 0;
+    randomSeed(_c + 1);
+    for (uint16_t _i = 0; _i < REPLAY_COUNT; _i++)
+    {
+      uint16_t _len = makeStream(_c);
+      _old += oldReceive(stream, _len);
+      uint32_t _t = micros();
+      _new += newReceive(stream, _len);
+      _time += micros() - _t;
+    }
+    Serial.printf(" %-22s  %10.1f%%  %11.1f%%  %15.1f\r\n", case_name[_c], _old * 100.0 / REPLAY_COUNT, _new * 100.0 / REPLAY_COUNT, (float)_time / REPLAY_COUNT);
+  }
+}
+
+/***********************************************************************
+ * FUNCTION:    loop
+ * DESCRIPTION: loop process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void loop()
+{
+  vTaskDelay(1000);
+}
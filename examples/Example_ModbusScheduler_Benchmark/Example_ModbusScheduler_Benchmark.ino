@@ -0,0 +1,135 @@
+/***********************************************************************
+ * Project      :     Example_ModbusScheduler_Benchmark
+ * Description  :     Poll mixed device list with tiny32_ModbusScheduler and
+ *                    print requested vs achieved period of each point.
+ *                    RS485 port 2 (RXD3/TXD3) simulate the slave devices,
+ *                    connect A-A and B-B of RS485 port 1 and port 2
+ * Hardware     :     tiny32_v3
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17/10/2026
+ * Revision     :     1.0
+ * Rev1.0       :     Origital
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     +66 89-140-7205
+ ***********************************************************************/
+#include <Arduino.h>
+#include <tiny32_v3.h>
+
+/**************************************/
+/*        define object variable      */
+/**************************************/
+tiny32_v3 mcu;
+tiny32_ModbusScheduler scheduler(modbus_rs485);
+
+/**************************************/
+/*        define global variable      */
+/**************************************/
+#define SLAVE_LATENCY_MS 20 // answer time of simulated slave
+#define REPORT_MS 30000
+
+uint8_t pzem_1[20];     // PZEM-016 id 1, 10 register
+uint8_t pzem_2[20];     // PZEM-016 id 2, 10 register
+uint8_t sdm630[144];    // SDM630MCT id 3, register 0x00-0x47
+uint8_t wtr10[4];       // WTR10-E id 4, temperature + humidity
+uint8_t schneider[12];  // Schneider PM2xxx id 5, current A/B/C
+uint8_t chiller[8];     // CHILLER R717 id 6, run hour
+uint32_t report_ms;
+
+/***********************************************************************
+ * FUNCTION:    slave_task
+ * DESCRIPTION: Simulated ModbusRTU slave id 1-6 on RS485 port 2, answer
+ *              function 0x03/0x04 with register value = address
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void slave_task(void *arg)
+{
+  HardwareSerial &port = modbus_rs485_2.port();
+  uint8_t frame[MODBUS_FRAME_MAX];
+  uint16_t len = 0;
+  uint32_t last_rx = micros();
+  uint32_t silence = tiny32_ModbusMaster::silence_us(port.baudRate());
+
+  for (;;)
+  {
+    while (port.available())
+    {
+      uint8_t b = port.read();
+      if (len < sizeof(frame))
+        frame[len++] = b;
+      last_rx = micros();
+    }
+
+    if ((len >= 8) && ((micros() - last_rx) >= silence))
+    {
+      uint16_t address = tiny32_ModbusMaster::toUint16(&frame[2]);
+      uint16_t quantity = tiny32_ModbusMaster::toUint16(&frame[4]);
+
+      if ((tiny32_ModbusMaster::crc16(frame, len) == 0) && (frame[0] >= 1) && (frame[0] <= 6) &&
+          ((frame[1] == 0x03) || (frame[1] == 0x04)) && (quantity <= MODBUS_REGISTER_MAX))
+      {
+        vTaskDelay(SLAVE_LATENCY_MS);
+        frame[2] = quantity * 2;
+        for (uint16_t i = 0; i < quantity; i++)
+        {
+          frame[3 + i * 2] = (address + i) >> 8;
+          frame[4 + i * 2] = (address + i) & 0xff;
+        }
+        tiny32_ModbusMaster::appendCRC(frame, 3 + quantity * 2);
+        port.write(frame, 5 + quantity * 2);
+        port.flush();
+      }
+      len = 0;
+    }
+    else if ((len > 0) && ((micros() - last_rx) >= silence))
+    {
+      len = 0; // noise
+    }
+    vTaskDelay(1);
+  }
+}
+
+/***********************************************************************
+ * FUNCTION:    setup
+ * DESCRIPTION: setup process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void setup()
+{
+  Serial.begin(115200);
+  Serial.printf("*** Example_ModbusScheduler_Benchmark ***\r\n");
+  mcu.library_version();
+
+  mcu.PZEM_016_begin(RXD2, TXD2);
+  modbus_rs485_2.port().begin(9600, SERIAL_8N1, RXD3, TXD3);
+  xTaskCreatePinnedToCore(slave_task, "slave", 4096, NULL, 3, NULL, 1);
+
+  /*** fast point (power) and slow point (temperature, run hour) ***/
+  scheduler.addPoint(1, 0x04, 0x0000, 10, 1000, pzem_1);
+  scheduler.addPoint(2, 0x04, 0x0000, 10, 1000, pzem_2);
+  scheduler.addPoint(3, 0x04, 0x0000, 72, 500, sdm630);
+  scheduler.addPoint(4, 0x03, 0x0000, 2, 10000, wtr10);
+  scheduler.addPoint(5, 0x03, 0x0BB7, 6, 2000, schneider);
+  scheduler.addPoint(6, 0x04, 0x009D, 4, 60000, chiller);
+
+  scheduler.beginTask(2, 0);
+  report_ms = millis();
+}
+
+/***********************************************************************
+ * FUNCTION:    loop
+ * DESCRIPTION: loop process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void loop()
+{
+  if ((millis() - report_ms) >= REPORT_MS)
+  {
+    report_ms = millis();
+    scheduler.printStatus();
+  }
+  vTaskDelay(100);
+}
@@ -0,0 +1,91 @@
+/***********************************************************************
+ * Project      :     Example_ModbusTag
+ * Description  :     Poll task on core 0 read SDM630MCT and Chiller R717,
+ *                    every value is published to modbus_tag automatically.
+ *                    Application (loop) on core 1 read the latest value,
+ *                    sequence, age and quality at memory speed (no bus)
+ * Hardware     :     tiny32_v3
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17/10/2026
+ * Revision     :     1.0
+ * Rev1.0       :     Origital
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     +66 89-140-7205
+ ***********************************************************************/
+#include <Arduino.h>
+#include <tiny32_v3.h>
+
+/**************************************/
+/*        define object variable      */
+/**************************************/
+tiny32_v3 mcu;
+
+/**************************************/
+/*        define global variable      */
+/**************************************/
+uint8_t meter_id = 1;
+uint8_t chiller_id = 2;
+tiny32_SDM630MCT meter;
+tiny32_CHILLER_R717 chiller;
+
+/***********************************************************************
+ * FUNCTION:    poll_task
+ * DESCRIPTION: Read both device every second (write side of tag store)
+ * PARAMETERS:  arg
+ * RETURNED:    nothing
+ ***********************************************************************/
+void poll_task(void *arg)
+{
+  for (;;)
+  {
+    mcu.SDM630MCT_read(meter_id, meter);
+    mcu.CHILLER_R717_read(chiller_id, chiller);
+    vTaskDelay(1000);
+  }
+}
+
+/***********************************************************************
+ * FUNCTION:    setup
+ * DESCRIPTION: setup process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void setup()
+{
+  Serial.begin(115200);
+  mcu.SDM630MCT_begin(RXD2, TXD2);
+  mcu.CHILLER_R717_begin(RXD2, TXD2);
+  Serial.printf("*** Example_ModbusTag ***\r\n");
+  mcu.library_version();
+  xTaskCreatePinnedToCore(poll_task, "poll", 4096, NULL, 2, NULL, 0);
+}
+
+/***********************************************************************
+ * FUNCTION:    loop
+ * DESCRIPTION: loop process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void loop()
+{
+  static uint32_t _last_sequence = 0;
+  tiny32_ModbusTagValue _v;
+  int16_t _freq = modbus_tag.find("SDM630MCT", "Freq", meter_id);
+  int16_t _kw = modbus_tag.find("CHILLER_R717", "TOTAL_KW", chiller_id);
+
+  /* value older than 5 second is MODBUS_QUALITY_STALE */
+  if (modbus_tag.read(_freq, &_v, 5000) && (_v.sequence != _last_sequence))
+  {
+    _last_sequence = _v.sequence;
+    Serial.printf("Info: Freq %.2f Hz (sequence %u, age %u mS)\r\n", _v.value, (unsigned)_v.sequence, (unsigned)(millis() - _v.time_ms));
+  }
+  if (modbus_tag.read(_kw, &_v, 5000))
+    Serial.printf("Info: Chiller %.1f kW\r\n", _v.value);
+  else if (_kw >= 0)
+    Serial.printf("Info: Chiller kW quality %d\r\n", _v.quality);
+
+  if ((millis() / 1000) % 30 == 0)
+    modbus_tag.printTag();
+  vTaskDelay(1000);
+}
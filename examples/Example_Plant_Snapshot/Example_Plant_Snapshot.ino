@@ -0,0 +1,77 @@
+/***********************************************************************
+ * Project      :     Example_Plant_Snapshot
+ * Description  :     Refresh Chiller R717 (3 FC04 request) and Inverter
+ *                    ATESS (1 FC04 request) on the same RS485 bus with
+ *                    CHILLER_R717_read/ ATESS_read, show value with validity
+ * Hardware     :     tiny32_v3
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17/10/2026
+ * Revision     :     1.0
+ * Rev1.0       :     Origital
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     +66 89-140-7205
+ ***********************************************************************/
+#include <Arduino.h>
+#include <tiny32_v3.h>
+
+/**************************************/
+/*        define object variable      */
+/**************************************/
+tiny32_v3 mcu;
+
+/**************************************/
+/*        define global variable      */
+/**************************************/
+uint8_t chiller_id = 1;
+uint8_t inverter_id = 2;
+tiny32_CHILLER_R717 chiller; // snapshot (getters use copy of the last read)
+tiny32_ATESS inverter;
+
+/***********************************************************************
+ * FUNCTION:    setup
+ * DESCRIPTION: setup process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void setup()
+{
+  Serial.begin(115200);
+  mcu.CHILLER_R717_begin(RXD2, TXD2);
+  mcu.ATESS_R717_begin(RXD2, TXD2);
+  Serial.printf("*** Example_Plant_Snapshot ***\r\n");
+  mcu.library_version();
+}
+
+/***********************************************************************
+ * FUNCTION:    loop
+ * DESCRIPTION: loop process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void loop()
+{
+  uint32_t _start = millis();
+
+  if (!mcu.CHILLER_R717_read(chiller_id, chiller))
+    Serial.printf("Error: Chiller is not answer (or part of it)\r\n");
+  if (!mcu.ATESS_read(inverter_id, inverter))
+    Serial.printf("Error: Inverter is not answer\r\n");
+  Serial.printf("Info: plant refresh %d mS\r\n", (int)(millis() - _start));
+
+  for (uint8_t _i = 0; _i < tiny32_CHILLER_R717::FIELD_COUNT; _i++)
+  {
+    if (chiller.isValid(_i))
+      Serial.printf("Info: %-28s => %.1f\r\n", tiny32_CHILLER_R717_map.reg(_i)->name, chiller.value[_i]);
+  }
+  for (uint8_t _i = 0; _i < tiny32_ATESS::FIELD_COUNT; _i++)
+  {
+    if (inverter.isValid(_i))
+      Serial.printf("Info: %-28s => %.1f\r\n", tiny32_ATESS_map.reg(_i)->name, inverter.value[_i]);
+  }
+
+  /* old getter use the snapshot (within cache TTL) */
+  Serial.printf("Info: Chiller %.1f kW, PV %.1f kW, SOC %.1f %%\r\n", mcu.CHILLER_R717_TOTAL_KW(chiller_id), mcu.ATESS_Power_PV_kW(inverter_id), mcu.ATESS_SOC(inverter_id));
+  Serial.printf("*****************************\r\n");
+  vTaskDelay(1000);
+}
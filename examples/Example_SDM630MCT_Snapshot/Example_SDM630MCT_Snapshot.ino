@@ -0,0 +1,73 @@
+/***********************************************************************
+ * Project      :     Example_SDM630MCT_Snapshot
+ * Description  :     Read all 3-phase value of EASTRON SDM630MCT in one
+ *                    FC04 request (SDM630MCT_read), getters called after it
+ *                    use the snapshot within cache TTL (no bus access)
+ * Hardware     :     tiny32_v3
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17/10/2026
+ * Revision     :     1.0
+ * Rev1.0       :     Origital
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     +66 89-140-7205
+ ***********************************************************************/
+#include <Arduino.h>
+#include <tiny32_v3.h>
+
+/**************************************/
+/*        define object variable      */
+/**************************************/
+tiny32_v3 mcu;
+
+/**************************************/
+/*        define global variable      */
+/**************************************/
+uint8_t id = 1;          // SDM630MCT address
+tiny32_SDM630MCT meter;  // snapshot (getters use copy of the last read)
+
+/***********************************************************************
+ * FUNCTION:    setup
+ * DESCRIPTION: setup process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void setup()
+{
+  Serial.begin(115200);
+  mcu.SDM630MCT_begin(RXD2, TXD2);
+  Serial.printf("*** Example_SDM630MCT_Snapshot ***\r\n");
+  mcu.library_version();
+}
+
+/***********************************************************************
+ * FUNCTION:    loop
+ * DESCRIPTION: loop process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void loop()
+{
+  uint32_t _start = millis();
+
+  if (!mcu.SDM630MCT_read(id, meter))
+  {
+    Serial.printf("Error: SDM630MCT is not answer\r\n");
+    vTaskDelay(1000);
+    return;
+  }
+
+  Serial.printf("Info: snapshot %d mS\r\n", (int)(millis() - _start));
+  Serial.printf("Info: Volt    %7.1f %7.1f %7.1f V\r\n", meter.P1_Volt(), meter.P2_Volt(), meter.P3_Volt());
+  Serial.printf("Info: Current %7.2f %7.2f %7.2f A\r\n", meter.P1_Current(), meter.P2_Current(), meter.P3_Current());
+  Serial.printf("Info: Power   %7.1f %7.1f %7.1f W\r\n", meter.P1_Watt(), meter.P2_Watt(), meter.P3_Watt());
+  Serial.printf("Info: PF      %7.2f %7.2f %7.2f\r\n", meter.P1_PF(), meter.P2_PF(), meter.P3_PF());
+  Serial.printf("Info: Total   %.1f W, %.1f VA, %.1f VAr, %.1f Hz\r\n", meter.Total_Watt(), meter.Total_VA(), meter.Total_VAr(), meter.Freq());
+
+  /* old getter use the snapshot (within cache TTL) */
+  _start = millis();
+  float _freq = mcu.SDM630MCT_Freq(id);
+  Serial.printf("Info: SDM630MCT_Freq => %.1f Hz (%d mS)\r\n", _freq, (int)(millis() - _start));
+  Serial.printf("*****************************\r\n");
+  vTaskDelay(500);
+}
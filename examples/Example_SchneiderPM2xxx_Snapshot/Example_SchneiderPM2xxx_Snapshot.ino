@@ -0,0 +1,84 @@
+/***********************************************************************
+ * Project      :     Example_SchneiderPM2xxx_Snapshot
+ * Description  :     Read metering value of many Schneider PM2xxx on one
+ *                    RS485 bus (SchneiderPM2xxx_read), all value in 2 FC03
+ *                    request for each meter, power/PF every round and
+ *                    the other value every 10th round (field mask)
+ * Hardware     :     tiny32_v3
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17/10/2026
+ * Revision     :     1.0
+ * Rev1.0       :     Origital
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     +66 89-140-7205
+ ***********************************************************************/
+#include <Arduino.h>
+#include <tiny32_v3.h>
+
+/**************************************/
+/*        define object variable      */
+/**************************************/
+tiny32_v3 mcu;
+
+/**************************************/
+/*          define parameter          */
+/**************************************/
+#define METER_MAX 12   // meter on switchboard, address 1-12
+#define FAST_MASK (SCHNEIDER_PM2XXX_POWER | SCHNEIDER_PM2XXX_PF)
+
+/**************************************/
+/*        define global variable      */
+/**************************************/
+tiny32_SchneiderPM2xxx meter[METER_MAX]; // snapshot of each meter
+uint32_t round_count = 0;
+
+/***********************************************************************
+ * FUNCTION:    setup
+ * DESCRIPTION: setup process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void setup()
+{
+  Serial.begin(115200);
+  mcu.SchneiderPM2xxx_begin(RXD2, TXD2);
+  Serial.printf("*** Example_SchneiderPM2xxx_Snapshot ***\r\n");
+  mcu.library_version();
+  tiny32_SchneiderPM2xxx_map.printMap();
+}
+
+/***********************************************************************
+ * FUNCTION:    loop
+ * DESCRIPTION: loop process
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void loop()
+{
+  uint64_t _mask = ((round_count % 10) == 0) ? MODBUS_FIELD_ALL : FAST_MASK;
+  uint32_t _start = millis();
+
+  for (uint8_t _i = 0; _i < METER_MAX; _i++)
+  {
+    if (!mcu.SchneiderPM2xxx_read(_i + 1, meter[_i], _mask))
+      Serial.printf("Error: meter %d is not answer\r\n", _i + 1);
+  }
+  Serial.printf("Info: %d meter, %d request each, %d mS\r\n", METER_MAX, tiny32_SchneiderPM2xxx_map.blockCount(_mask), (int)(millis() - _start));
+
+  for (uint8_t _i = 0; _i < METER_MAX; _i++)
+  {
+    tiny32_SchneiderPM2xxx &_m = meter[_i];
+
+    if (!_m.isValid(tiny32_SchneiderPM2xxx::REG_ActivePowerTotal))
+      continue;
+    Serial.printf("Info: meter %2d  %7.2f kW  %7.2f kVAR  %7.2f kVA  PF %5.2f", _i + 1, _m.ActivePowerTotal(), _m.ReactivePowerTotal(), _m.ApparentPowerTotal(), _m.PowerFactorTotal());
+    if (_m.isValid(tiny32_SchneiderPM2xxx::REG_Freq))
+      Serial.printf("  %6.1f V  %6.2f A  %5.2f Hz", _m.Voltage_LN_Avg(), _m.CurrentAvg(), _m.Freq());
+    Serial.printf("\r\n");
+  }
+
+  round_count++;
+  Serial.printf("*****************************\r\n");
+  vTaskDelay(1000);
+}
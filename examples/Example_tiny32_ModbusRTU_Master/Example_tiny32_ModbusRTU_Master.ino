@@ -90,6 +90,10 @@ void loop()
   // mcu.tiny32_ModbusRTU(id,value_1);
   // vTaskDelay(1000);
 
+  // float value[TINY32_MODBUSRTU_FLOAT_MAX]; // any start address, up to 62 float in one frame
+  // mcu.tiny32_ModbusRTU_read(id, 0x0000, value, 10);
+  // vTaskDelay(1000);
+
   Serial.printf("Info: value_1 => %.2f\r\n", value_1);
   Serial.printf("Info: value_2 => %.2f\r\n", value_2);
   Serial.printf("Info: value_3 => %.2f\r\n", value_3);
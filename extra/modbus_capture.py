@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""
+File         :     modbus_capture.py
+Description  :     Convert ModbusRTU frame capture of tiny32_ModbusCapture
+                   (binary stream of drain(), or "CAPTURE:<hex>" line that
+                   Example_ModbusCapture print out) to text or pcap file
+Author       :     Tenergy Innovation Co., Ltd.
+Date         :     17 Oct 2026
+website      :     http://www.tenergyinnovation.co.th
+
+usage:  python3 modbus_capture.py capture.bin            (text to screen)
+        python3 modbus_capture.py capture.log -o out.pcap (pcap, open with Wireshark)
+
+pcap use link type DLT_USER0 (147), each packet = [bus][direction][outcome] + frame
+"""
+import argparse
+import binascii
+import struct
+import sys
+
+SYNC = 0xA5
+HEADER = 11
+OUTCOME = ["success", "timeout", "incomplete", "crc", "id error", "function error", "exception", "parameter error"]
+
+
+def load(path):
+    raw = open(path, "rb").read()
+    if raw[:1] == bytes([SYNC]):
+        return raw
+    stream = b""
+    for line in raw.decode("ascii", "ignore").splitlines():
+        if "CAPTURE:" in line:
+            stream += binascii.unhexlify(line.split("CAPTURE:", 1)[1].strip())
+    return stream
+
+
+def records(stream):
+    i = 0
+    while i + HEADER <= len(stream):
+        if stream[i] != SYNC:
+            i += 1  # resync
+            continue
+        time_us, bus, direction, outcome, length, data_len = struct.unpack_from("<IBBBHB", stream, i + 1)
+        data = stream[i + HEADER:i + HEADER + data_len]
+        if len(data) < data_len:
+            break
+        yield time_us, bus, direction, outcome, length, data
+        i += HEADER + data_len
+
+
+def write_text(frames, out):
+    start = None
+    for time_us, bus, direction, outcome, length, data in frames:
+        start = time_us if start is None else start
+        text = "%12.3f ms  bus%d  %s" % (((time_us - start) & 0xFFFFFFFF) / 1000.0, bus, "TX" if direction == 0 else "RX")
+        if direction != 0:
+            text += "  %-15s" % (OUTCOME[outcome] if outcome < len(OUTCOME) else outcome)
+        text += "  " + " ".join("%02X" % b for b in data)
+        if length > len(data):
+            text += " ..(%d byte)" % length
+        out.write(text + "\n")
+
+
+def write_pcap(frames, path):
+    with open(path, "wb") as f:
+        f.write(struct.pack("<IHHiIII", 0xA1B2C3D4, 2, 4, 0, 0, 65535, 147))
+        wrap = 0
+        last = None
+        for time_us, bus, direction, outcome, length, data in frames:
+            if last is not None and time_us < last:
+                wrap += 1 << 32  # micros() roll over
+            last = time_us
+            t = time_us + wrap
+            packet = bytes([bus, direction, outcome]) + data
+            f.write(struct.pack("<IIII", t // 1000000, t % 1000000, len(packet), len(packet) + length - len(data)))
+            f.write(packet)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="tiny32 ModbusRTU capture converter")
+    parser.add_argument("capture", help="binary stream or log with CAPTURE:<hex> line")
+    parser.add_argument("-o", "--output", help="pcap file (text to screen if not set)")
+    args = parser.parse_args()
+
+    frames = list(records(load(args.capture)))
+    if args.output:
+        write_pcap(frames, args.output)
+        print("%d frame => %s" % (len(frames), args.output))
+    else:
+        write_text(frames, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
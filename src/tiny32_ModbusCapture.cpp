@@ -0,0 +1,210 @@
+/***********************************************************************
+ * File         :     tiny32_ModbusCapture.cpp
+ * Description  :     Runtime capture of ModbusRTU frame (TX/RX) into a lock
+ *                    free ring buffer with uS timestamp, bus id and outcome.
+ *                    Drain as compact binary stream, convert offline with
+ *                    extra/modbus_capture.py (text or pcap)
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17 Oct 2026
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     089-140-7205
+ ***********************************************************************/
+
+#include "tiny32_ModbusCapture.h"
+#include "Arduino.h"
+
+static_assert((MODBUS_CAPTURE_SIZE & (MODBUS_CAPTURE_SIZE - 1)) == 0, "MODBUS_CAPTURE_SIZE must be power of 2");
+
+tiny32_ModbusCapture modbus_capture;
+
+tiny32_ModbusCapture::tiny32_ModbusCapture(void) : _head(0)
+{
+  _tail = 0;
+  _lost = 0;
+  _enable = false;
+  memset(_frame, 0, sizeof(_frame));
+}
+
+/***********************************************************************
+ * FUNCTION:    enable
+ * DESCRIPTION: Start/ stop capture (bus only check one flag when stop)
+ * PARAMETERS:  enable
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusCapture::enable(bool enable)
+{
+  _enable = enable;
+}
+
+/***********************************************************************
+ * FUNCTION:    clear
+ * DESCRIPTION: Drop all captured frame (call from consumer)
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusCapture::clear(void)
+{
+  _tail = _head.load(std::memory_order_acquire);
+  _lost = 0;
+}
+
+/***********************************************************************
+ * FUNCTION:    record
+ * DESCRIPTION: Keep one frame, lock free (each bus task reserve own slot
+ *              with atomic index, the oldest frame is overwritten when
+ *              ring buffer is full)
+ * PARAMETERS:  bus, direction, outcome, time_us, data, length
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusCapture::record(uint8_t bus, uint8_t direction, uint8_t outcome, uint32_t time_us, const uint8_t *data, uint16_t length)
+{
+  if (!_enable)
+    return;
+
+  uint32_t _index = _head.fetch_add(1, std::memory_order_relaxed);
+  tiny32_ModbusFrame *_f = &_frame[_index & (MODBUS_CAPTURE_SIZE - 1)];
+
+  __atomic_store_n(&_f->sequence, 0, __ATOMIC_RELAXED); // being written
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  _f->time_us = time_us;
+  _f->bus = bus;
+  _f->direction = direction;
+  _f->outcome = outcome;
+  _f->length = length;
+  memcpy(_f->data, data, (length < MODBUS_CAPTURE_DATA) ? length : MODBUS_CAPTURE_DATA);
+  __atomic_store_n(&_f->sequence, _index + 1, __ATOMIC_RELEASE);
+}
+
+/***********************************************************************
+ * FUNCTION:    read
+ * DESCRIPTION: Copy the oldest frame (one consumer only), frame that was
+ *              overwritten while copy is skipped and count as lost
+ * PARAMETERS:  frame
+ * RETURNED:    true = frame was copied, false = no frame
+ ***********************************************************************/
+bool tiny32_ModbusCapture::read(tiny32_ModbusFrame *frame)
+{
+  for (;;)
+  {
+    uint32_t _head_now = _head.load(std::memory_order_acquire);
+
+    if (_head_now - _tail > MODBUS_CAPTURE_SIZE)
+    {
+      _lost += _head_now - _tail - MODBUS_CAPTURE_SIZE; // overwritten
+      _tail = _head_now - MODBUS_CAPTURE_SIZE;
+    }
+
+    if (_tail == _head_now)
+      return false;
+
+    tiny32_ModbusFrame *_f = &_frame[_tail & (MODBUS_CAPTURE_SIZE - 1)];
+    uint32_t _sequence = __atomic_load_n(&_f->sequence, __ATOMIC_ACQUIRE);
+
+    if (_sequence != _tail + 1)
+    {
+      if ((_sequence == 0) || ((int32_t)(_sequence - (_tail + 1)) < 0))
+        return false; // still being written
+
+      _lost++; // overwritten by newer frame
+      _tail++;
+      continue;
+    }
+
+    memcpy(frame, _f, sizeof(tiny32_ModbusFrame));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&_f->sequence, __ATOMIC_ACQUIRE) != _sequence)
+    {
+      _lost++; // overwritten while copy
+      _tail++;
+      continue;
+    }
+
+    _tail++;
+    return true;
+  }
+}
+
+/***********************************************************************
+ * FUNCTION:    drain
+ * DESCRIPTION: Move captured frame to buffer as binary stream (only whole
+ *              record, see tiny32_ModbusCapture.h for record format)
+ * PARAMETERS:  buffer, size
+ * RETURNED:    byte in buffer, 0 = no frame
+ ***********************************************************************/
+uint16_t tiny32_ModbusCapture::drain(uint8_t *buffer, uint16_t size)
+{
+  tiny32_ModbusFrame _f;
+  uint16_t _len = 0;
+
+  while (size - _len >= MODBUS_CAPTURE_HEADER + MODBUS_CAPTURE_DATA)
+  {
+    if (!read(&_f))
+      break;
+
+    uint8_t _data_len = (_f.length < MODBUS_CAPTURE_DATA) ? _f.length : MODBUS_CAPTURE_DATA;
+    uint8_t *_p = &buffer[_len];
+    _p[0] = MODBUS_CAPTURE_SYNC;
+    _p[1] = _f.time_us & 0xFF;
+    _p[2] = (_f.time_us >> 8) & 0xFF;
+    _p[3] = (_f.time_us >> 16) & 0xFF;
+    _p[4] = (_f.time_us >> 24) & 0xFF;
+    _p[5] = _f.bus;
+    _p[6] = _f.direction;
+    _p[7] = _f.outcome;
+    _p[8] = _f.length & 0xFF;
+    _p[9] = (_f.length >> 8) & 0xFF;
+    _p[10] = _data_len;
+    memcpy(&_p[MODBUS_CAPTURE_HEADER], _f.data, _data_len);
+    _len += MODBUS_CAPTURE_HEADER + _data_len;
+  }
+
+  return _len;
+}
+
+/***********************************************************************
+ * FUNCTION:    printCapture
+ * DESCRIPTION: Print out and remove all captured frame as text
+ *              "time_us bus TX/RX outcome : hex"
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusCapture::printCapture(void)
+{
+  tiny32_ModbusFrame _f;
+
+  while (read(&_f))
+  {
+    Serial.printf("%10u  bus%d  %s  %d  :", (unsigned)_f.time_us, _f.bus, (_f.direction == MODBUS_CAPTURE_TX) ? "TX" : "RX", _f.outcome);
+    for (uint16_t _i = 0; (_i < _f.length) && (_i < MODBUS_CAPTURE_DATA); _i++)
+      Serial.printf(" %02X", _f.data[_i]);
+    Serial.printf((_f.length > MODBUS_CAPTURE_DATA) ? " ..(%d byte)\r\n" : "\r\n", _f.length);
+  }
+
+  if (_lost)
+    Serial.printf("Info: %u frame was lost (overwritten)\r\n", (unsigned)_lost);
+}
+
+/***********************************************************************
+ * FUNCTION:    available
+ * DESCRIPTION: Number of frame waiting for read/ drain
+ * PARAMETERS:  nothing
+ * RETURNED:    frame
+ ***********************************************************************/
+uint32_t tiny32_ModbusCapture::available(void)
+{
+  uint32_t _count = _head.load(std::memory_order_acquire) - _tail;
+
+  return (_count > MODBUS_CAPTURE_SIZE) ? MODBUS_CAPTURE_SIZE : _count;
+}
+
+/***********************************************************************
+ * FUNCTION:    lost
+ * DESCRIPTION: Number of frame that was overwritten before read
+ * PARAMETERS:  nothing
+ * RETURNED:    frame
+ ***********************************************************************/
+uint32_t tiny32_ModbusCapture::lost(void)
+{
+  return _lost;
+}
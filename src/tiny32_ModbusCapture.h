@@ -0,0 +1,71 @@
+/***********************************************************************
+ * File         :     tiny32_ModbusCapture.h
+ * Description  :     Runtime capture of ModbusRTU frame (TX/RX) into a lock
+ *                    free ring buffer with uS timestamp, bus id and outcome.
+ *                    Drain as compact binary stream, convert offline with
+ *                    extra/modbus_capture.py (text or pcap)
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17 Oct 2026
+ * Revision     :     1.0
+ * Rev1.0       :     Original
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     089-140-7205
+ ***********************************************************************/
+
+#ifndef TINY32_MODBUSCAPTURE_H
+#define TINY32_MODBUSCAPTURE_H
+#include <atomic>
+#include "Arduino.h"
+
+/**************************************/
+/*     ModbusRTU capture define       */
+/**************************************/
+#define MODBUS_CAPTURE_SIZE 64   // number of frame in ring buffer (power of 2)
+#define MODBUS_CAPTURE_DATA 64   // maximum byte of frame that is kept (longer frame is cut)
+#define MODBUS_CAPTURE_TX 0      // request (master => slave)
+#define MODBUS_CAPTURE_RX 1      // response (all byte that was received)
+#define MODBUS_CAPTURE_SYNC 0xA5 // first byte of each record in binary stream
+#define MODBUS_CAPTURE_HEADER 11 // byte of record header in binary stream
+
+/*  binary stream record (little endian)
+ *  [0xA5][time_us 4][bus 1][direction 1][outcome 1][length 2][data_len 1][data data_len]
+ *  outcome = MODBUS_OK/ MODBUS_ERROR_xxx of transaction (always 0 for TX)
+ *  length  = length of frame on the bus, data_len = byte that was kept
+ */
+struct tiny32_ModbusFrame
+{
+    uint32_t sequence; // index + 1 of frame, 0 = frame is being written
+    uint32_t time_us;  // micros() of TX start/ first RX byte
+    uint8_t bus;
+    uint8_t direction; // MODBUS_CAPTURE_TX/ MODBUS_CAPTURE_RX
+    uint8_t outcome;
+    uint16_t length;
+    uint8_t data[MODBUS_CAPTURE_DATA];
+};
+
+class tiny32_ModbusCapture
+{
+public:
+    tiny32_ModbusCapture(void);
+    void enable(bool enable);
+    bool enabled(void) { return _enable; }
+    void clear(void);
+    void record(uint8_t bus, uint8_t direction, uint8_t outcome, uint32_t time_us, const uint8_t *data, uint16_t length);
+
+    bool read(tiny32_ModbusFrame *frame);
+    uint16_t drain(uint8_t *buffer, uint16_t size);
+    void printCapture(void);
+    uint32_t available(void);
+    uint32_t lost(void);
+
+private:
+    tiny32_ModbusFrame _frame[MODBUS_CAPTURE_SIZE];
+    std::atomic<uint32_t> _head; // next frame index of producer (bus task)
+    uint32_t _tail;              // next frame index of consumer (drain/read)
+    uint32_t _lost;              // frame that was overwritten before read
+    volatile bool _enable;
+};
+
+extern tiny32_ModbusCapture modbus_capture;
+#endif
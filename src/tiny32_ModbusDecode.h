@@ -0,0 +1,172 @@
+/***********************************************************************
+ * File         :     tiny32_ModbusDecode.h
+ * Description  :     Compile time ModbusRTU register decoder (template),
+ *                    int16/uint16/int32/uint32/int64/uint64/float/double in
+ *                    ABCD/CDAB/BADC/DCBA word order with compile time scale.
+ *                    Byte order and scale are template parameter, so each
+ *                    decoder is straight line shift/or code without loop,
+ *                    branch or type punning
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17 Oct 2026
+ * Revision     :     1.0
+ * Rev1.0       :     Original
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     089-140-7205
+ ***********************************************************************/
+
+#ifndef TINY32_MODBUSDECODE_H
+#define TINY32_MODBUSDECODE_H
+#include <type_traits>
+#include <string.h>
+#include <stdint.h>
+
+/**************************************/
+/*     ModbusRTU word order define    */
+/**************************************/
+/* byte on the bus A B C D ... (A = first received byte) */
+#define MODBUS_ORDER_ABCD 0 // high word first, high byte first (Modbus standard, SDM, Schneider, ENenergic)
+#define MODBUS_ORDER_CDAB 1 // low word first, high byte first (PZEM, tiny32 ModbusRTU)
+#define MODBUS_ORDER_BADC 2 // high word first, low byte first
+#define MODBUS_ORDER_DCBA 3 // low word first, low byte first (little endian)
+
+/***********************************************************************
+ * FUNCTION:    tiny32_modbusByte
+ * DESCRIPTION: Position in data of the byte k of value (k = 0 is the
+ *              most significant byte)
+ * PARAMETERS:  order, size (byte of value), k
+ * RETURNED:    index of data
+ ***********************************************************************/
+constexpr uint8_t tiny32_modbusByte(uint8_t order, uint8_t size, uint8_t k)
+{
+    return (order == MODBUS_ORDER_DCBA)   ? (uint8_t)(size - 1 - k)
+           : (order == MODBUS_ORDER_BADC) ? (uint8_t)(k ^ 1)
+           : (order == MODBUS_ORDER_CDAB) ? (uint8_t)(size - 2 - (k & 0xFE) + (k & 1))
+                                          : k;
+}
+
+/* collect byte k-1..0 of unsigned U (one shift/or for each byte, unrolled by template) */
+template <typename U, uint8_t ORDER, uint8_t K>
+struct tiny32_ModbusBytes
+{
+    static constexpr U get(const uint8_t *data)
+    {
+        return (U)((U)(tiny32_ModbusBytes<U, ORDER, K - 1>::get(data) << 8) | data[tiny32_modbusByte(ORDER, sizeof(U), K - 1)]);
+    }
+};
+
+template <typename U, uint8_t ORDER>
+struct tiny32_ModbusBytes<U, ORDER, 0>
+{
+    static constexpr U get(const uint8_t *) { return 0; }
+};
+
+/* raw bit of T and decoded value type (float, double for 64 bit) */
+template <typename T>
+struct tiny32_ModbusType
+{
+    typedef typename std::make_unsigned<T>::type bits;
+    typedef typename std::conditional<(sizeof(T) == 8), double, float>::type value;
+    static constexpr T cast(bits b) { return (T)b; }
+};
+
+template <>
+struct tiny32_ModbusType<float>
+{
+    typedef uint32_t bits;
+    typedef float value;
+    static float cast(uint32_t b)
+    {
+        float _f;
+        memcpy(&_f, &b, sizeof(_f)); // no punning, compiler make it register move
+        return _f;
+    }
+};
+
+template <>
+struct tiny32_ModbusType<double>
+{
+    typedef uint64_t bits;
+    typedef double value;
+    static double cast(uint64_t b)
+    {
+        double _f;
+        memcpy(&_f, &b, sizeof(_f));
+        return _f;
+    }
+};
+
+/***********************************************************************
+ * CLASS:       tiny32_ModbusValue
+ * DESCRIPTION: Decoder of one value type
+ *              T      = int16_t, uint16_t, int32_t, uint32_t, int64_t,
+ *                       uint64_t, float or double
+ *              ORDER  = MODBUS_ORDER_xxxx (no effect for 16 bit value)
+ *              MUL/DIV = compile time scale, value = raw x MUL / DIV
+ *              e.g. PZEM current 0.001A low word first
+ *              tiny32_ModbusValue<uint32_t, MODBUS_ORDER_CDAB, 1, 1000>
+ ***********************************************************************/
+template <typename T, uint8_t ORDER = MODBUS_ORDER_ABCD, uint32_t MUL = 1, uint32_t DIV = 1>
+struct tiny32_ModbusValue
+{
+    typedef typename tiny32_ModbusType<T>::value value_type;
+    static constexpr uint8_t REGISTER = sizeof(T) / 2;
+
+    static_assert((sizeof(T) >= 2) && ((sizeof(T) % 2) == 0), "value must be whole register");
+    static_assert(DIV != 0, "DIV must not be 0");
+
+    /* compile time scale factor (1.0 = no multiply) */
+    static constexpr value_type scale(void) { return (value_type)MUL / (value_type)DIV; }
+
+    /* raw value, data point to first byte of register */
+    static T raw(const uint8_t *data)
+    {
+        return tiny32_ModbusType<T>::cast(tiny32_ModbusBytes<typename tiny32_ModbusType<T>::bits, ORDER, sizeof(T)>::get(data));
+    }
+
+    /* scaled value */
+    static value_type value(const uint8_t *data)
+    {
+        return ((MUL == 1) && (DIV == 1)) ? (value_type)raw(data) : (value_type)raw(data) * scale();
+    }
+
+    /* decode count value that follow each other in one pass, value may be
+       the same memory as data: value wider than register is decoded from
+       the last one, so no register is overwritten before it is read */
+    static void block(const uint8_t *data, value_type *value, uint16_t count)
+    {
+        if (sizeof(value_type) > sizeof(T))
+        {
+            for (uint16_t _i = count; _i > 0; _i--)
+                value[_i - 1] = tiny32_ModbusValue::value(&data[(_i - 1) * REGISTER * 2]);
+        }
+        else
+        {
+            for (uint16_t _i = 0; _i < count; _i++)
+                value[_i] = tiny32_ModbusValue::value(&data[_i * REGISTER * 2]);
+        }
+    }
+};
+
+/**************************************/
+/*     short name of common decoder   */
+/**************************************/
+template <uint8_t ORDER = MODBUS_ORDER_ABCD>
+using tiny32_ModbusFloat = tiny32_ModbusValue<float, ORDER>;
+
+template <uint32_t DIV = 1>
+using tiny32_ModbusUint16 = tiny32_ModbusValue<uint16_t, MODBUS_ORDER_ABCD, 1, DIV>;
+
+template <uint32_t DIV = 1>
+using tiny32_ModbusInt16 = tiny32_ModbusValue<int16_t, MODBUS_ORDER_ABCD, 1, DIV>;
+
+template <uint8_t ORDER = MODBUS_ORDER_ABCD, uint32_t DIV = 1>
+using tiny32_ModbusUint32 = tiny32_ModbusValue<uint32_t, ORDER, 1, DIV>;
+
+template <uint8_t ORDER = MODBUS_ORDER_ABCD, uint32_t DIV = 1>
+using tiny32_ModbusInt32 = tiny32_ModbusValue<int32_t, ORDER, 1, DIV>;
+
+template <uint8_t ORDER = MODBUS_ORDER_ABCD, uint32_t DIV = 1>
+using tiny32_ModbusCounter = tiny32_ModbusValue<uint64_t, ORDER, 1, DIV>; // 64 bit energy counter (4 register)
+
+#endif
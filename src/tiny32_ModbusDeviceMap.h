@@ -0,0 +1,218 @@
+/***********************************************************************
+ * File         :     tiny32_ModbusDeviceMap.h
+ * Description  :     Register map of ModbusRTU device of tiny32_v3
+ *                    (see tiny32_ModbusMap.h), new device = new list
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17 Oct 2026
+ * Revision     :     1.3
+ * Rev1.0       :     Original (CHILLER_R717, ATESS)
+ * Rev1.1       :     Add SDM630MCT
+ * Rev1.2       :     Add SchneiderPM2xxx
+ * Rev1.3       :     Add ENenergic and tiny32_ENenergicState (phasor)
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     089-140-7205
+ ***********************************************************************/
+
+#ifndef TINY32_MODBUSDEVICEMAP_H
+#define TINY32_MODBUSDEVICEMAP_H
+#include "tiny32_ModbusMap.h"
+
+/**************************************/
+/* EASTRON SDM630MCT (input register) */
+/**************************************/
+/*  name,                          function, address, format,    scale */
+#define SDM630MCT_REGISTER(X)                                                                                 \
+    X(P1_Volt,                       0x04, 0x0000, MODBUS_FLOAT, 1)    /* Phase 1 line to neutral volts (V) */\
+    X(P2_Volt,                       0x04, 0x0002, MODBUS_FLOAT, 1)    /* Phase 2 line to neutral volts (V) */\
+    X(P3_Volt,                       0x04, 0x0004, MODBUS_FLOAT, 1)    /* Phase 3 line to neutral volts (V) */\
+    X(P1_Current,                    0x04, 0x0006, MODBUS_FLOAT, 1)    /* Phase 1 current (A) */              \
+    X(P2_Current,                    0x04, 0x0008, MODBUS_FLOAT, 1)    /* Phase 2 current (A) */              \
+    X(P3_Current,                    0x04, 0x000A, MODBUS_FLOAT, 1)    /* Phase 3 current (A) */              \
+    X(P1_Watt,                       0x04, 0x000C, MODBUS_FLOAT, 1)    /* Phase 1 active power (W) */         \
+    X(P2_Watt,                       0x04, 0x000E, MODBUS_FLOAT, 1)    /* Phase 2 active power (W) */         \
+    X(P3_Watt,                       0x04, 0x0010, MODBUS_FLOAT, 1)    /* Phase 3 active power (W) */         \
+    X(P1_VA,                         0x04, 0x0012, MODBUS_FLOAT, 1)    /* Phase 1 apparent power (VA) */      \
+    X(P2_VA,                         0x04, 0x0014, MODBUS_FLOAT, 1)    /* Phase 2 apparent power (VA) */      \
+    X(P3_VA,                         0x04, 0x0016, MODBUS_FLOAT, 1)    /* Phase 3 apparent power (VA) */      \
+    X(P1_VAr,                        0x04, 0x0018, MODBUS_FLOAT, 1)    /* Phase 1 reactive power (VAr) */     \
+    X(P2_VAr,                        0x04, 0x001A, MODBUS_FLOAT, 1)    /* Phase 2 reactive power (VAr) */     \
+    X(P3_VAr,                        0x04, 0x001C, MODBUS_FLOAT, 1)    /* Phase 3 reactive power (VAr) */     \
+    X(P1_PF,                         0x04, 0x001E, MODBUS_FLOAT, 1)    /* Phase 1 power factor */             \
+    X(P2_PF,                         0x04, 0x0020, MODBUS_FLOAT, 1)    /* Phase 2 power factor */             \
+    X(P3_PF,                         0x04, 0x0022, MODBUS_FLOAT, 1)    /* Phase 3 power factor */             \
+    X(P1_Angle,                      0x04, 0x0024, MODBUS_FLOAT, 1)    /* Phase 1 phase angle (degree) */     \
+    X(P2_Angle,                      0x04, 0x0026, MODBUS_FLOAT, 1)    /* Phase 2 phase angle (degree) */     \
+    X(P3_Angle,                      0x04, 0x0028, MODBUS_FLOAT, 1)    /* Phase 3 phase angle (degree) */     \
+    X(Avg_Volt,                      0x04, 0x002A, MODBUS_FLOAT, 1)    /* Average line to neutral volts (V) */\
+    X(Avg_Current,                   0x04, 0x002E, MODBUS_FLOAT, 1)    /* Average line current (A) */         \
+    X(Sum_Current,                   0x04, 0x0030, MODBUS_FLOAT, 1)    /* Sum of line currents (A) */         \
+    X(Total_Watt,                    0x04, 0x0034, MODBUS_FLOAT, 1)    /* Total system power (W) */           \
+    X(Total_VA,                      0x04, 0x0038, MODBUS_FLOAT, 1)    /* Total system volt amps (VA) */      \
+    X(Total_VAr,                     0x04, 0x003C, MODBUS_FLOAT, 1)    /* Total system VAr */                 \
+    X(Total_PF,                      0x04, 0x003E, MODBUS_FLOAT, 1)    /* Total system power factor */        \
+    X(Total_Angle,                   0x04, 0x0042, MODBUS_FLOAT, 1)    /* Total system phase angle (degree) */\
+    X(Freq,                          0x04, 0x0046, MODBUS_FLOAT, 1)    /* Frequency (Hz) */
+
+MODBUS_DEVICE_MAP(SDM630MCT, SDM630MCT_REGISTER);
+
+/**************************************/
+/*  Schneider PM2xxx (holding reg.)   */
+/**************************************/
+/*  name,                          function, address, format,    scale */
+#define SCHNEIDER_PM2XXX_REGISTER(X)                                                                          \
+    X(CurrentA,                      0x03, 0x0BB7, MODBUS_FLOAT, 1)    /* Current A (A) */                    \
+    X(CurrentB,                      0x03, 0x0BB9, MODBUS_FLOAT, 1)    /* Current B (A) */                    \
+    X(CurrentC,                      0x03, 0x0BBB, MODBUS_FLOAT, 1)    /* Current C (A) */                    \
+    X(CurrentN,                      0x03, 0x0BBD, MODBUS_FLOAT, 1)    /* Current N (A) */                    \
+    X(CurrentG,                      0x03, 0x0BBF, MODBUS_FLOAT, 1)    /* Current G (A) */                    \
+    X(CurrentAvg,                    0x03, 0x0BC1, MODBUS_FLOAT, 1)    /* Current Avg (A) */                  \
+    X(CurrentUnblanceA,              0x03, 0x0BC3, MODBUS_FLOAT, 1)    /* Current Unbalance A (%) */          \
+    X(CurrentUnblanceB,              0x03, 0x0BC5, MODBUS_FLOAT, 1)    /* Current Unbalance B (%) */          \
+    X(CurrentUnblanceC,              0x03, 0x0BC7, MODBUS_FLOAT, 1)    /* Current Unbalance C (%) */          \
+    X(CurrentUnblanceWorst,          0x03, 0x0BC9, MODBUS_FLOAT, 1)    /* Current Unbalance Worst (%) */      \
+    X(Voltage_AB,                    0x03, 0x0BCB, MODBUS_FLOAT, 1)    /* Voltage A-B (V) */                  \
+    X(Voltage_BC,                    0x03, 0x0BCD, MODBUS_FLOAT, 1)    /* Voltage B-C (V) */                  \
+    X(Voltage_CA,                    0x03, 0x0BCF, MODBUS_FLOAT, 1)    /* Voltage C-A (V) */                  \
+    X(Voltage_LL_Avg,                0x03, 0x0BD1, MODBUS_FLOAT, 1)    /* Voltage L-L Avg (V) */              \
+    X(Voltage_AN,                    0x03, 0x0BD3, MODBUS_FLOAT, 1)    /* Voltage A-N (V) */                  \
+    X(Voltage_BN,                    0x03, 0x0BD5, MODBUS_FLOAT, 1)    /* Voltage B-N (V) */                  \
+    X(Voltage_CN,                    0x03, 0x0BD7, MODBUS_FLOAT, 1)    /* Voltage C-N (V) */                  \
+    X(Voltage_LN_Avg,                0x03, 0x0BDB, MODBUS_FLOAT, 1)    /* Voltage L-N Avg (V) */              \
+    X(VoltageUnblance_AB,            0x03, 0x0BDD, MODBUS_FLOAT, 1)    /* Voltage Unbalance A-B (%) */        \
+    X(VoltageUnblance_BC,            0x03, 0x0BDF, MODBUS_FLOAT, 1)    /* Voltage Unbalance B-C (%) */        \
+    X(VoltageUnblance_CA,            0x03, 0x0BE1, MODBUS_FLOAT, 1)    /* Voltage Unbalance C-A (%) */        \
+    X(VoltageUnblance_LL_Worst,      0x03, 0x0BE3, MODBUS_FLOAT, 1)    /* Voltage Unbalance L-L Worst (%) */  \
+    X(VoltageUnblance_AN,            0x03, 0x0BE5, MODBUS_FLOAT, 1)    /* Voltage Unbalance A-N (%) */        \
+    X(VoltageUnblance_BN,            0x03, 0x0BE7, MODBUS_FLOAT, 1)    /* Voltage Unbalance B-N (%) */        \
+    X(VoltageUnblance_CN,            0x03, 0x0BE9, MODBUS_FLOAT, 1)    /* Voltage Unbalance C-N (%) */        \
+    X(VoltageUnblance_LN_Worst,      0x03, 0x0BEB, MODBUS_FLOAT, 1)    /* Voltage Unbalance L-N Worst (%) */  \
+    X(ActivePowerA,                  0x03, 0x0BED, MODBUS_FLOAT, 1)    /* Active Power A (kW) */              \
+    X(ActivePowerB,                  0x03, 0x0BEF, MODBUS_FLOAT, 1)    /* Active Power B (kW) */              \
+    X(ActivePowerC,                  0x03, 0x0BF1, MODBUS_FLOAT, 1)    /* Active Power C (kW) */              \
+    X(ActivePowerTotal,              0x03, 0x0BF3, MODBUS_FLOAT, 1)    /* Active Power Total (kW) */          \
+    X(ReactivePowerA,                0x03, 0x0BF5, MODBUS_FLOAT, 1)    /* Reactive Power A (kVAR) */          \
+    X(ReactivePowerB,                0x03, 0x0BF7, MODBUS_FLOAT, 1)    /* Reactive Power B (kVAR) */          \
+    X(ReactivePowerC,                0x03, 0x0BF9, MODBUS_FLOAT, 1)    /* Reactive Power C (kVAR) */          \
+    X(ReactivePowerTotal,            0x03, 0x0BFB, MODBUS_FLOAT, 1)    /* Reactive Power Total (kVAR) */      \
+    X(ApparentPowerA,                0x03, 0x0BFD, MODBUS_FLOAT, 1)    /* Apparent Power A (kVA) */           \
+    X(ApparentPowerB,                0x03, 0x0BFF, MODBUS_FLOAT, 1)    /* Apparent Power B (kVA) */           \
+    X(ApparentPowerC,                0x03, 0x0C01, MODBUS_FLOAT, 1)    /* Apparent Power C (kVA) */           \
+    X(ApparentPowerTotal,            0x03, 0x0C03, MODBUS_FLOAT, 1)    /* Apparent Power Total (kVA) */       \
+    X(PowerFactorA,                  0x03, 0x0C05, MODBUS_FLOAT, 1)    /* Power Factor A */                   \
+    X(PowerFactorB,                  0x03, 0x0C07, MODBUS_FLOAT, 1)    /* Power Factor B */                   \
+    X(PowerFactorC,                  0x03, 0x0C09, MODBUS_FLOAT, 1)    /* Power Factor C */                   \
+    X(PowerFactorTotal,              0x03, 0x0C0B, MODBUS_FLOAT, 1)    /* Power Factor Total */               \
+    X(Freq,                          0x03, 0x0C25, MODBUS_FLOAT, 1)    /* Frequency (Hz) */
+
+MODBUS_DEVICE_MAP(SchneiderPM2xxx, SCHNEIDER_PM2XXX_REGISTER);
+
+/* field mask of SchneiderPM2xxx_read (OR them together), block of field not in mask is not read */
+#define SCHNEIDER_PM2XXX_CURRENT tiny32_modbusFieldMask(tiny32_SchneiderPM2xxx::REG_CurrentA, tiny32_SchneiderPM2xxx::REG_CurrentAvg)
+#define SCHNEIDER_PM2XXX_VOLTAGE tiny32_modbusFieldMask(tiny32_SchneiderPM2xxx::REG_Voltage_AB, tiny32_SchneiderPM2xxx::REG_Voltage_LN_Avg)
+#define SCHNEIDER_PM2XXX_UNBALANCE (tiny32_modbusFieldMask(tiny32_SchneiderPM2xxx::REG_CurrentUnblanceA, tiny32_SchneiderPM2xxx::REG_CurrentUnblanceWorst) | \
+                                    tiny32_modbusFieldMask(tiny32_SchneiderPM2xxx::REG_VoltageUnblance_AB, tiny32_SchneiderPM2xxx::REG_VoltageUnblance_LN_Worst))
+#define SCHNEIDER_PM2XXX_POWER tiny32_modbusFieldMask(tiny32_SchneiderPM2xxx::REG_ActivePowerA, tiny32_SchneiderPM2xxx::REG_ApparentPowerTotal)
+#define SCHNEIDER_PM2XXX_PF tiny32_modbusFieldMask(tiny32_SchneiderPM2xxx::REG_PowerFactorA, tiny32_SchneiderPM2xxx::REG_PowerFactorTotal)
+#define SCHNEIDER_PM2XXX_FREQ tiny32_modbusFieldMask(tiny32_SchneiderPM2xxx::REG_Freq, tiny32_SchneiderPM2xxx::REG_Freq)
+
+/**************************************/
+/*  ENenergic meter (holding register) */
+/**************************************/
+/*  name,                          function, address, format,    scale */
+#define ENENERGIC_REGISTER(X)                                                                                 \
+    X(Volt_L1_N,                     0x03, 0x0000, MODBUS_FLOAT, 1)    /* Voltage L1-N (V) */                 \
+    X(Volt_L2_N,                     0x03, 0x0002, MODBUS_FLOAT, 1)    /* Voltage L2-N (V) */                 \
+    X(Volt_L3_N,                     0x03, 0x0004, MODBUS_FLOAT, 1)    /* Voltage L3-N (V) */                 \
+    X(Volt_L1_L2,                    0x03, 0x0008, MODBUS_FLOAT, 1)    /* Voltage L1-L2 (V) */                \
+    X(Volt_L2_L3,                    0x03, 0x000A, MODBUS_FLOAT, 1)    /* Voltage L2-L3 (V) */                \
+    X(Volt_L3_L1,                    0x03, 0x000C, MODBUS_FLOAT, 1)    /* Voltage L3-L1 (V) */                \
+    X(Current_L1,                    0x03, 0x000E, MODBUS_FLOAT, 1)    /* Current L1 (A) */                   \
+    X(Current_L2,                    0x03, 0x0010, MODBUS_FLOAT, 1)    /* Current L2 (A) */                   \
+    X(Current_L3,                    0x03, 0x0012, MODBUS_FLOAT, 1)    /* Current L3 (A) */                   \
+    X(NeutralCurrent,                0x03, 0x0016, MODBUS_FLOAT, 1)    /* Neutral current (A) */              \
+    X(Freq,                          0x03, 0x0018, MODBUS_FLOAT, 1)    /* Frequency (Hz) */                   \
+    X(VoltAngle_L1,                  0x03, 0x006A, MODBUS_FLOAT, 1)    /* Phase voltage angle L1 (degree) */  \
+    X(VoltAngle_L2,                  0x03, 0x006C, MODBUS_FLOAT, 1)    /* Phase voltage angle L2 (degree) */  \
+    X(VoltAngle_L3,                  0x03, 0x006E, MODBUS_FLOAT, 1)    /* Phase voltage angle L3 (degree) */  \
+    X(CurrentAngle_L1,               0x03, 0x0072, MODBUS_FLOAT, 1)    /* Phase current angle L1 (degree) */  \
+    X(CurrentAngle_L2,               0x03, 0x0074, MODBUS_FLOAT, 1)    /* Phase current angle L2 (degree) */  \
+    X(CurrentAngle_L3,               0x03, 0x0076, MODBUS_FLOAT, 1)    /* Phase current angle L3 (degree) */  \
+    X(Temperature,                   0x03, 0x0080, MODBUS_FLOAT, 1)    /* Internal temperature (°C) */
+
+MODBUS_DEVICE_MAP(ENenergic, ENENERGIC_REGISTER);
+
+/* phasor of one phase (angle in degree as the meter give) */
+struct tiny32_Phasor
+{
+    float magnitude;
+    float angle;
+    float real(void) const { return magnitude * cosf(angle * DEG_TO_RAD); }
+    float imag(void) const { return magnitude * sinf(angle * DEG_TO_RAD); }
+};
+
+/* full state of ENenergic meter (ENenergic_readState), phasor of 3 phase */
+struct tiny32_ENenergicState
+{
+    tiny32_Phasor volt[3];    // L1-N, L2-N, L3-N (V, degree)
+    tiny32_Phasor current[3]; // L1, L2, L3 (A, degree)
+    float volt_LL[3];         // L1-L2, L2-L3, L3-L1 (V)
+    float neutral_current;    // (A)
+    float freq;               // (Hz)
+    float temperature;        // (°C)
+    tiny32_ENenergic raw;     // register snapshot (valid, id, time_ms)
+};
+
+/**************************************/
+/*   Chiller R717 (input register)    */
+/**************************************/
+/*  name,                          function, address, format,    scale */
+#define CHILLER_R717_REGISTER(X)                                                                              \
+    X(AI01_CHILLED_IN,               0x04, 0x0001, MODBUS_INT16, 0.1)  /* Chilled water Temp Inlet (°C) */    \
+    X(AI02_CHILLED_OUT,              0x04, 0x0002, MODBUS_INT16, 0.1)  /* Chilled water Temp Outlet (°C) */   \
+    X(AI03_COOLED_IN,                0x04, 0x0003, MODBUS_INT16, 0.1)  /* Cooled water Temp Inlet (°C) */     \
+    X(AI04_COOLED_OUT,               0x04, 0x0004, MODBUS_INT16, 0.1)  /* Cooled water Temp Outlet (°C) */    \
+    X(AI05_SUCTION_TEMP,             0x04, 0x0005, MODBUS_INT16, 0.1)  /* Suction Temp Compressor (°C) */     \
+    X(AI06_DISCHARGE_TEMP,           0x04, 0x0006, MODBUS_INT16, 0.1)  /* Discharge Temp Compressor (°C) */   \
+    X(AI08_COND_PRESS,               0x04, 0x0008, MODBUS_INT16, 0.1)  /* Condenser Pressure */               \
+    X(AI10_EVAP_PRESS,               0x04, 0x000A, MODBUS_INT16, 0.1)  /* Evap Pressure */                    \
+    X(Slurry1_Temp,                  0x04, 0x000B, MODBUS_INT16, 0.1)  /* Slurry 1 Temp (°C) */               \
+    X(Slurry2_Temp,                  0x04, 0x000C, MODBUS_INT16, 0.1)  /* Slurry 2 Temp (°C) */               \
+    X(Slurry3_Temp,                  0x04, 0x000D, MODBUS_INT16, 0.1)  /* Slurry 3 Temp (°C) */               \
+    X(Slurry4_Temp,                  0x04, 0x000E, MODBUS_INT16, 0.1)  /* Slurry 4 Temp (°C) */               \
+    X(Coil_Temp,                     0x04, 0x000F, MODBUS_INT16, 0.1)  /* Fan Coil Temp (°C) */               \
+    X(Room_Temp,                     0x04, 0x0010, MODBUS_INT16, 0.1)  /* Room Temp (°C) */                   \
+    X(CURRENT_COMP,                  0x04, 0x0014, MODBUS_INT16, 0.1)  /* Current Compressor (A) */           \
+    X(VOLT_COMP,                     0x04, 0x0015, MODBUS_INT16, 0.1)  /* Voltage Compressor (V) */           \
+    X(FREQ_COMP,                     0x04, 0x0016, MODBUS_INT16, 0.1)  /* Frequency Compressor (Hz) */        \
+    X(POWER_COMP,                    0x04, 0x0017, MODBUS_INT16, 0.1)  /* Power Compressor (kW) */            \
+    X(PER_COMP,                      0x04, 0x0033, MODBUS_INT16, 0.1)  /* % Compressor */                     \
+    X(HOUR_CHILLED_PUMP,             0x04, 0x009D, MODBUS_INT16, 0.1)  /* Hour of Chilled Pump (hr) */        \
+    X(HOUR_COMP,                     0x04, 0x009E, MODBUS_INT16, 0.1)  /* Hour of Compressor (hr) */          \
+    X(HOUR_COOLED_PUMP,              0x04, 0x009F, MODBUS_INT16, 0.1)  /* Hour of Cooled Pump (hr) */         \
+    X(HOUR_COOLING_TOWER,            0x04, 0x00A0, MODBUS_INT16, 0.1)  /* Hour of Cooling Tower (hr) */       \
+    X(SP_ROOM,                       0x04, 0x0144, MODBUS_INT16, 0.1)  /* Set Point Temp of Room (°C) */      \
+    X(TOTAL_KW,                      0x04, 0x0147, MODBUS_INT16, 0.1)  /* Total kW of system */
+
+MODBUS_DEVICE_MAP(CHILLER_R717, CHILLER_R717_REGISTER);
+
+/**************************************/
+/*   Inverter ATESS (input register)  */
+/**************************************/
+/*  name,                          function, address, format,    scale */
+#define ATESS_REGISTER(X)                                                                                     \
+    X(Power_bat_kW,                  0x04, 0x0011, MODBUS_INT16, 0.1)  /* Battery power (kW) */               \
+    X(ActivePower_Grid_kW,           0x04, 0x0013, MODBUS_INT16, 0.1)  /* Bypass active power (kW) */         \
+    X(Energy_BatDischargeToday_kWh,  0x04, 0x0018, MODBUS_INT16, 0.1)  /* Battery daily discharge (kWh) */    \
+    X(Energy_BatChargeToday_kWh,     0x04, 0x001A, MODBUS_INT16, 0.1)  /* Battery daily charge (kWh) */       \
+    X(SOC,                           0x04, 0x002F, MODBUS_INT16, 0.1)  /* Battery percentage (%) */           \
+    X(ActivePower_Load_kW,           0x04, 0x0031, MODBUS_INT16, 0.1)  /* Load active power (kW) */           \
+    X(Power_PV_kW,                   0x04, 0x0033, MODBUS_INT16, 0.1)  /* PV1 power (kW) */                   \
+    X(Energy_PVToday_kWh,            0x04, 0x003E, MODBUS_INT16, 0.1)  /* PV daily generation (kWh) */        \
+    X(Energy_LoadToday_kWh,          0x04, 0x0052, MODBUS_INT16, 0.1)  /* Daily consumption of load (kWh) */  \
+    X(Energy_GridInToday_kWh,        0x04, 0x0058, MODBUS_INT16, 0.1)  /* Daily intake from grid (kWh) */     \
+    X(Energy_GridOutToday_kWh,       0x04, 0x005E, MODBUS_INT16, 0.1)  /* Daily fed to grid (kWh) */
+
+MODBUS_DEVICE_MAP(ATESS, ATESS_REGISTER);
+
+#endif
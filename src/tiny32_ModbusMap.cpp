@@ -0,0 +1,238 @@
+/***********************************************************************
+ * File         :     tiny32_ModbusMap.cpp
+ * Description  :     Declarative ModbusRTU device register map. One list of
+ *                    (name, function, address, format, scale) make the
+ *                    snapshot struct (value, validity, getter), the constexpr
+ *                    register table and the coalesced block read of device
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17 Oct 2026
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     089-140-7205
+ ***********************************************************************/
+
+#include "tiny32_ModbusMap.h"
+#include "Arduino.h"
+
+/***********************************************************************
+ * FUNCTION:    find
+ * DESCRIPTION: Index of register by name
+ * PARAMETERS:  name
+ * RETURNED:    index, -1 = not found
+ ***********************************************************************/
+int16_t tiny32_ModbusMap::find(const char *name) const
+{
+  for (uint8_t _i = 0; _i < _count; _i++)
+  {
+    if (strcmp(_reg[_i].name, name) == 0)
+      return _i;
+  }
+
+  return -1;
+}
+
+/***********************************************************************
+ * FUNCTION:    block
+ * DESCRIPTION: Plan one block read from register first, merge the next
+ *              register in mask (same function code) while unused
+ *              register <= max_gap and block <= MODBUS_REGISTER_MAX
+ * PARAMETERS:  first (register in mask), mask, max_gap, *address, *quantity
+ * RETURNED:    index of the last register in block
+ ***********************************************************************/
+uint8_t tiny32_ModbusMap::block(uint8_t first, uint64_t mask, uint16_t max_gap, uint16_t *address, uint16_t *quantity) const
+{
+  const tiny32_ModbusRegister *_first = &_reg[first];
+  uint16_t _end = _first->address + tiny32_ModbusPlanner::registers(_first->format);
+  uint8_t _last = first;
+
+  for (uint8_t _i = first + 1; _i < _count; _i++)
+  {
+    const tiny32_ModbusRegister *_r = &_reg[_i];
+
+    if (!((mask >> _i) & 1))
+      continue;
+    if (_r->function != _first->function)
+      break;
+
+    uint16_t _r_end = _r->address + tiny32_ModbusPlanner::registers(_r->format);
+    if ((_r->address > _end + max_gap) || ((_r_end - _first->address) > MODBUS_REGISTER_MAX))
+      break;
+
+    if (_r_end > _end)
+      _end = _r_end;
+    _last = _i;
+  }
+
+  *address = _first->address;
+  *quantity = _end - _first->address;
+  return _last;
+}
+
+/***********************************************************************
+ * FUNCTION:    blockCount
+ * DESCRIPTION: Number of block read of one read (no bus access)
+ * PARAMETERS:  mask, max_gap
+ * RETURNED:    block
+ ***********************************************************************/
+uint8_t tiny32_ModbusMap::blockCount(uint64_t mask, uint16_t max_gap) const
+{
+  uint16_t _address, _quantity;
+  uint8_t _block = 0;
+
+  for (uint8_t _i = 0; _i < _count; _i++)
+  {
+    if (!((mask >> _i) & 1))
+      continue;
+
+    _i = block(_i, mask, max_gap, &_address, &_quantity);
+    _block++;
+  }
+
+  return _block;
+}
+
+/***********************************************************************
+ * FUNCTION:    read
+ * DESCRIPTION: Read register in mask with as few block read as possible,
+ *              decode each register to value[index] (x scale). Valid bit
+ *              of register in mask is renewed, value of failed block is
+ *              not changed. Block that device answer with exception is
+ *              split at the gap and read again, read stop at the first
+ *              timeout. Each register is published to modbus_tag
+ * PARAMETERS:  bus, id, value (count of map), *valid, mask, max_gap
+ * RETURNED:    true = all register in mask was read, false = some fail
+ ***********************************************************************/
+bool tiny32_ModbusMap::read(tiny32_ModbusMaster &bus, uint8_t id, float *value, uint64_t *valid, uint64_t mask, uint16_t max_gap) const
+{
+  uint8_t _data[MODBUS_REGISTER_MAX * 2];
+  uint16_t _address, _quantity;
+  bool _success = true;
+
+  *valid &= ~mask;
+
+  for (uint8_t _i = 0; _i < _count; _i++)
+  {
+    if (!((mask >> _i) & 1))
+      continue;
+
+    uint8_t _first = _i;
+    _i = block(_first, mask, max_gap, &_address, &_quantity);
+
+    if (!bus.readRegisters(id, _reg[_first].function, _address, _quantity, _data))
+    {
+      /* device may refuse reserved register in the gap, read this block again without gap */
+      if ((bus.lastError() == MODBUS_ERROR_EXCEPTION) && (max_gap > 0) && (_i > _first))
+        _success &= read(bus, id, value, valid, mask & tiny32_modbusFieldMask(_first, _i), 0);
+      else if (bus.lastError() == MODBUS_ERROR_TIMEOUT)
+      {
+        publishBad(bus, id, mask & tiny32_modbusFieldMask(_first, MODBUS_DEVICE_FIELD_MAX - 1));
+        return false; // device is not answer, do not wait timeout of every block
+      }
+      else
+      {
+        publishBad(bus, id, mask & tiny32_modbusFieldMask(_first, _i));
+        _success = false;
+      }
+      continue;
+    }
+
+    for (uint8_t _j = _first; _j <= _i; _j++)
+    {
+      if (!((mask >> _j) & 1))
+        continue;
+
+      value[_j] = tiny32_ModbusPlanner::decode(&_data[(_reg[_j].address - _address) * 2], _reg[_j].format, _reg[_j].scale);
+      *valid |= (uint64_t)1 << _j;
+      modbus_tag.publish(bus.busId(), id, _reg[_j].function, _reg[_j].address, value[_j], true, _name, _reg[_j].name);
+    }
+  }
+
+  return _success;
+}
+
+/***********************************************************************
+ * FUNCTION:    readPoint
+ * DESCRIPTION: Read one register (compatibility getter of device)
+ * PARAMETERS:  bus, id, index
+ * RETURNED:    value (x scale), -1 = error
+ ***********************************************************************/
+float tiny32_ModbusMap::readPoint(tiny32_ModbusMaster &bus, uint8_t id, uint8_t index) const
+{
+  uint8_t _data[4];
+
+  if (index >= _count)
+  {
+    Serial.printf("Error: Register index %d is out of %s map\r\n", index, _name);
+    return -1;
+  }
+
+  const tiny32_ModbusRegister *_r = &_reg[index];
+  if (!bus.readRegisters(id, _r->function, _r->address, tiny32_ModbusPlanner::registers(_r->format), _data))
+  {
+    modbus_tag.publish(bus.busId(), id, _r->function, _r->address, 0, false);
+    return -1;
+  }
+
+  float _value = tiny32_ModbusPlanner::decode(_data, _r->format, _r->scale);
+  modbus_tag.publish(bus.busId(), id, _r->function, _r->address, _value, true, _name, _r->name);
+  return _value;
+}
+
+/***********************************************************************
+ * FUNCTION:    publishBad
+ * DESCRIPTION: Mark tag of register in mask as bad (read fail)
+ * PARAMETERS:  bus, id, mask
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMap::publishBad(tiny32_ModbusMaster &bus, uint8_t id, uint64_t mask) const
+{
+  for (uint8_t _i = 0; _i < _count; _i++)
+  {
+    if ((mask >> _i) & 1)
+      modbus_tag.publish(bus.busId(), id, _reg[_i].function, _reg[_i].address, 0, false);
+  }
+}
+
+/***********************************************************************
+ * FUNCTION:    add
+ * DESCRIPTION: Add register in mask to planner (plan with point of other
+ *              device on the same bus)
+ * PARAMETERS:  planner, id, value (count of map), mask
+ * RETURNED:    true/ false (planner is full)
+ ***********************************************************************/
+bool tiny32_ModbusMap::add(tiny32_ModbusPlanner &planner, uint8_t id, float *value, uint64_t mask) const
+{
+  for (uint8_t _i = 0; _i < _count; _i++)
+  {
+    if (!((mask >> _i) & 1))
+      continue;
+
+    if (planner.add(id, _reg[_i].function, _reg[_i].address, _reg[_i].format, &value[_i], _reg[_i].scale) < 0)
+      return false;
+  }
+
+  return true;
+}
+
+/***********************************************************************
+ * FUNCTION:    printMap
+ * DESCRIPTION: Print out register map and block read of all register
+ * PARAMETERS:  max_gap
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMap::printMap(uint16_t max_gap) const
+{
+  uint16_t _address, _quantity;
+
+  Serial.printf("\r\nInfo: %s map, %d register => %d block (max gap = %d)\r\n", _name, _count, blockCount(MODBUS_FIELD_ALL, max_gap), max_gap);
+  Serial.printf("index  function  address  format  scale  name\r\n");
+  for (uint8_t _i = 0; _i < _count; _i++)
+    Serial.printf("%5d  0x%02X      0x%04X   %6d  %5g  %s\r\n", _i, _reg[_i].function, _reg[_i].address, _reg[_i].format, _reg[_i].scale, _reg[_i].name);
+
+  for (uint8_t _i = 0; _i < _count; _i++)
+  {
+    uint8_t _first = _i;
+    _i = block(_first, MODBUS_FIELD_ALL, max_gap, &_address, &_quantity);
+    Serial.printf("block: function 0x%02X, address 0x%04X, quantity %d (register %d-%d)\r\n", _reg[_first].function, _address, _quantity, _first, _i);
+  }
+}
@@ -0,0 +1,225 @@
+/***********************************************************************
+ * File         :     tiny32_ModbusMap.h
+ * Description  :     Declarative ModbusRTU device register map. One list of
+ *                    (name, function, address, format, scale) make the
+ *                    snapshot struct (value, validity, getter), the constexpr
+ *                    register table and the coalesced block read of device
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17 Oct 2026
+ * Revision     :     1.3
+ * Rev1.0       :     Original
+ * Rev1.1       :     tiny32_modbusFieldMask, merged block that device refuse
+ *                    (exception) is read again without gap
+ * Rev1.2       :     read stop at the first timeout (device is not answer)
+ * Rev1.3       :     Publish every register that was read to modbus_tag
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     089-140-7205
+ ***********************************************************************/
+
+#ifndef TINY32_MODBUSMAP_H
+#define TINY32_MODBUSMAP_H
+#include "Arduino.h"
+#include "tiny32_ModbusMaster.h"
+#include "tiny32_ModbusPlanner.h"
+#include "tiny32_ModbusTag.h"
+
+/**************************************/
+/*     ModbusRTU device map define    */
+/**************************************/
+#define MODBUS_DEVICE_FIELD_MAX 64     // maximum register of one map (bit of valid)
+#define MODBUS_FIELD_ALL 0xFFFFFFFFFFFFFFFFULL // mask of all field
+#ifndef MODBUS_SNAPSHOT_ID_MAX
+#define MODBUS_SNAPSHOT_ID_MAX 16 // device (bus, id) of one map kept by tiny32_ModbusSnapshotStore
+#endif
+
+/* one register of device (format = MODBUS_UINT16.. of tiny32_ModbusPlanner.h) */
+struct tiny32_ModbusRegister
+{
+    const char *name;
+    uint8_t function;
+    uint16_t address;
+    uint8_t format;
+    float scale;
+};
+
+/***********************************************************************
+ * FUNCTION:    tiny32_modbusMapSorted
+ * DESCRIPTION: Check at compile time that register is in function code/
+ *              address order (block read is made in one pass)
+ * PARAMETERS:  reg, count
+ * RETURNED:    true/ false
+ ***********************************************************************/
+constexpr bool tiny32_modbusMapSorted(const tiny32_ModbusRegister *reg, uint8_t count)
+{
+    return (count < 2) || (((reg[0].function < reg[1].function) || ((reg[0].function == reg[1].function) && (reg[0].address < reg[1].address))) &&
+                           tiny32_modbusMapSorted(reg + 1, count - 1));
+}
+
+/***********************************************************************
+ * FUNCTION:    tiny32_modbusFieldMask
+ * DESCRIPTION: Mask of field first..last (index REG_xxx of snapshot), group
+ *              of field for read mask
+ * PARAMETERS:  first, last
+ * RETURNED:    mask
+ ***********************************************************************/
+constexpr uint64_t tiny32_modbusFieldMask(uint8_t first, uint8_t last)
+{
+    return ((last >= 63) ? MODBUS_FIELD_ALL : (((uint64_t)1 << (last + 1)) - 1)) & ~(((uint64_t)1 << first) - 1);
+}
+
+/* snapshot of MODBUS_DEVICE_MAP kept for each (bus, id), copy in/ out under
+   mux so task that read and task that get value never see half of snapshot,
+   new (bus, id) take place of the oldest one when store is full */
+template <typename SNAPSHOT, uint8_t SIZE = MODBUS_SNAPSHOT_ID_MAX>
+class tiny32_ModbusSnapshotStore
+{
+public:
+    tiny32_ModbusSnapshotStore() { memset(_slot, 0, sizeof(_slot)); }
+
+    void put(tiny32_ModbusMaster &bus, const SNAPSHOT &snapshot)
+    {
+        uint8_t _slot_index = 0;
+
+        portENTER_CRITICAL(&_mux);
+        for (uint8_t _i = 0; _i < SIZE; _i++)
+        {
+            if ((_slot[_i].bus == &bus) && (_slot[_i].snapshot.id == snapshot.id))
+            {
+                _slot_index = _i;
+                break;
+            }
+            if (_slot[_slot_index].bus == NULL) // empty slot is taken first
+                continue;
+            if ((_slot[_i].bus == NULL) || ((int32_t)(_slot[_i].snapshot.time_ms - _slot[_slot_index].snapshot.time_ms) < 0))
+                _slot_index = _i;
+        }
+        _slot[_slot_index].bus = &bus;
+        _slot[_slot_index].snapshot = snapshot;
+        portEXIT_CRITICAL(&_mux);
+    }
+
+    /* value of field index when (bus, id) was read within ttl_ms and field is valid */
+    bool value(tiny32_ModbusMaster &bus, uint8_t id, uint8_t index, uint32_t ttl_ms, float &value)
+    {
+        bool _found = false;
+
+        portENTER_CRITICAL(&_mux);
+        for (uint8_t _i = 0; _i < SIZE; _i++)
+        {
+            const SNAPSHOT &_snapshot = _slot[_i].snapshot;
+            if ((_slot[_i].bus == &bus) && (_snapshot.id == id))
+            {
+                _found = _snapshot.isValid(index) && ((millis() - _snapshot.time_ms) < ttl_ms);
+                if (_found)
+                    value = _snapshot.value[index];
+                break;
+            }
+        }
+        portEXIT_CRITICAL(&_mux);
+        return _found;
+    }
+
+private:
+    struct
+    {
+        tiny32_ModbusMaster *bus; // NULL = empty
+        SNAPSHOT snapshot;
+    } _slot[SIZE];
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+};
+
+class tiny32_ModbusMap
+{
+public:
+    constexpr tiny32_ModbusMap(const char *name, const tiny32_ModbusRegister *reg, uint8_t count) : _name(name), _reg(reg), _count(count) {}
+
+    const char *name(void) const { return _name; }
+    uint8_t count(void) const { return _count; }
+    const tiny32_ModbusRegister *reg(uint8_t index) const { return (index < _count) ? &_reg[index] : NULL; }
+    int16_t find(const char *name) const;
+
+    uint8_t block(uint8_t first, uint64_t mask, uint16_t max_gap, uint16_t *address, uint16_t *quantity) const;
+    uint8_t blockCount(uint64_t mask = MODBUS_FIELD_ALL, uint16_t max_gap = MODBUS_PLAN_GAP) const;
+    bool read(tiny32_ModbusMaster &bus, uint8_t id, float *value, uint64_t *valid, uint64_t mask = MODBUS_FIELD_ALL, uint16_t max_gap = MODBUS_PLAN_GAP) const;
+    float readPoint(tiny32_ModbusMaster &bus, uint8_t id, uint8_t index) const;
+    bool add(tiny32_ModbusPlanner &planner, uint8_t id, float *value, uint64_t mask = MODBUS_FIELD_ALL) const;
+    void printMap(uint16_t max_gap = MODBUS_PLAN_GAP) const;
+
+    /* read into snapshot struct of MODBUS_DEVICE_MAP (valid = field of this read only) */
+    template <typename SNAPSHOT>
+    bool read(tiny32_ModbusMaster &bus, uint8_t id, SNAPSHOT &snapshot, uint64_t mask = MODBUS_FIELD_ALL, uint16_t max_gap = MODBUS_PLAN_GAP) const
+    {
+        if (SNAPSHOT::FIELD_COUNT != _count)
+        {
+            Serial.printf("Error: Snapshot is not %s map\r\n", _name);
+            return false;
+        }
+        snapshot.id = id;
+        snapshot.time_ms = millis();
+        snapshot.valid = 0;
+        return read(bus, id, snapshot.value, &snapshot.valid, mask, max_gap);
+    }
+
+    /* value of snapshot when it is valid within snapshot TTL of bus, read one register if not */
+    template <typename SNAPSHOT>
+    float readPoint(tiny32_ModbusMaster &bus, uint8_t id, uint8_t index, const SNAPSHOT *snapshot) const
+    {
+        if ((snapshot != NULL) && (snapshot->id == id) && snapshot->isValid(index) && ((millis() - snapshot->time_ms) < bus.getSnapshotTTL()))
+            return snapshot->value[index];
+        return readPoint(bus, id, index);
+    }
+
+    /* value of (bus, id) in store when it is valid within snapshot TTL of bus, read one register if not */
+    template <typename SNAPSHOT, uint8_t SIZE>
+    float readPoint(tiny32_ModbusMaster &bus, uint8_t id, uint8_t index, tiny32_ModbusSnapshotStore<SNAPSHOT, SIZE> &store) const
+    {
+        float _value;
+
+        if (store.value(bus, id, index, bus.getSnapshotTTL(), _value))
+            return _value;
+        return readPoint(bus, id, index);
+    }
+
+private:
+    const char *_name;
+    const tiny32_ModbusRegister *_reg;
+    uint8_t _count;
+    void publishBad(tiny32_ModbusMaster &bus, uint8_t id, uint64_t mask) const;
+};
+
+/**************************************/
+/*        device map generator        */
+/**************************************/
+/*  LIST(X) = X(name, function, address, format, scale) X(...) ...
+ *  (register in function code/ address order)
+ *  MODBUS_DEVICE_MAP(DEV, LIST) make
+ *    struct tiny32_DEV      : snapshot, value[], valid, id, time_ms, getter name() and index REG_name
+ *    tiny32_DEV_register[]  : constexpr register table
+ *    tiny32_DEV_map         : tiny32_ModbusMap (read/ readPoint/ add/ printMap)
+ */
+#define MODBUS_MAP_INDEX(name, function, address, format, scale) REG_##name,
+#define MODBUS_MAP_GETTER(name, function, address, format, scale) \
+    float name(void) const { return value[REG_##name]; }
+#define MODBUS_MAP_REGISTER(name, function, address, format, scale) {#name, function, address, format, scale},
+
+#define MODBUS_DEVICE_MAP(device, LIST)                                                                                           \
+    struct tiny32_##device                                                                                                        \
+    {                                                                                                                             \
+        enum                                                                                                                      \
+        {                                                                                                                         \
+            LIST(MODBUS_MAP_INDEX) FIELD_COUNT                                                                                    \
+        };                                                                                                                        \
+        float value[FIELD_COUNT];                                                                                                 \
+        uint64_t valid;   /* bit n = value[n] was updated by the last read */                                                     \
+        uint8_t id;       /* address of the last read */                                                                          \
+        uint32_t time_ms; /* millis() of the last read */                                                                         \
+        bool isValid(uint8_t index) const { return (index < FIELD_COUNT) && ((valid >> index) & 1); }                             \
+        LIST(MODBUS_MAP_GETTER)                                                                                                   \
+    };                                                                                                                            \
+    static constexpr tiny32_ModbusRegister tiny32_##device##_register[] = {LIST(MODBUS_MAP_REGISTER)};                            \
+    static constexpr tiny32_ModbusMap tiny32_##device##_map(#device, tiny32_##device##_register, tiny32_##device::FIELD_COUNT);   \
+    static_assert(tiny32_##device::FIELD_COUNT <= MODBUS_DEVICE_FIELD_MAX, #device " map has too many register");                 \
+    static_assert(tiny32_modbusMapSorted(tiny32_##device##_register, tiny32_##device::FIELD_COUNT), #device " map is not in address order")
+
+#endif
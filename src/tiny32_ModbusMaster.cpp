@@ -0,0 +1,1921 @@
+/***********************************************************************
+ * File         :     tiny32_ModbusMaster.cpp
+ * Description  :     ModbusRTU master engine (request builder, response
+ *                    parser and register decoder) for tiny32_v3 module
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17 Oct 2026
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@innovation.co.th
+ * TEL          :     089-140-7205
+ ***********************************************************************/
+
+#include "tiny32_ModbusMaster.h"
+#include "Arduino.h"
+
+// #define modbusRTU_Debug
+
+/**************************************/
+/*   CRC16 table (build by compiler)  */
+/**************************************/
+static constexpr uint16_t crc16_shift(uint16_t crc, uint8_t bit)
+{
+  return (bit == 0) ? crc : crc16_shift((crc & 1) ? ((crc >> 1) ^ 0xA001) : (crc >> 1), bit - 1);
+}
+#define CRC16_T1(n) crc16_shift((n), 8)
+#define CRC16_T4(n) CRC16_T1(n), CRC16_T1(n + 1), CRC16_T1(n + 2), CRC16_T1(n + 3)
+#define CRC16_T16(n) CRC16_T4(n), CRC16_T4(n + 4), CRC16_T4(n + 8), CRC16_T4(n + 12)
+#define CRC16_T64(n) CRC16_T16(n), CRC16_T16(n + 16), CRC16_T16(n + 32), CRC16_T16(n + 48)
+static constexpr uint16_t _crc16_table[256] = {CRC16_T64(0), CRC16_T64(64), CRC16_T64(128), CRC16_T64(192)};
+static_assert(_crc16_table[1] == 0xC0C1 && _crc16_table[255] == 0x4040, "CRC16 table error");
+
+/* byte order of tiny32_ModbusDecode.h (checked at compile time) */
+static constexpr uint8_t _decode_test[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+static_assert(tiny32_ModbusBytes<uint32_t, MODBUS_ORDER_ABCD, 4>::get(_decode_test) == 0x01020304, "ABCD decode error");
+static_assert(tiny32_ModbusBytes<uint32_t, MODBUS_ORDER_CDAB, 4>::get(_decode_test) == 0x03040102, "CDAB decode error");
+static_assert(tiny32_ModbusBytes<uint32_t, MODBUS_ORDER_BADC, 4>::get(_decode_test) == 0x02010403, "BADC decode error");
+static_assert(tiny32_ModbusBytes<uint32_t, MODBUS_ORDER_DCBA, 4>::get(_decode_test) == 0x04030201, "DCBA decode error");
+static_assert(tiny32_ModbusBytes<uint64_t, MODBUS_ORDER_CDAB, 8>::get(_decode_test) == 0x0708050603040102ULL, "64 bit CDAB decode error");
+static_assert(tiny32_ModbusBytes<uint16_t, MODBUS_ORDER_CDAB, 2>::get(_decode_test) == 0x0102, "16 bit decode error");
+
+tiny32_ModbusMaster::tiny32_ModbusMaster(HardwareSerial &port, uint8_t bus_id) : _port(port)
+{
+  _bus_id = bus_id;
+  _mutex = xSemaphoreCreateRecursiveMutex();
+  _default_baud = 0; // line is not managed until begin
+  _default_config = SERIAL_8N1;
+  _probe_baud = 0;
+  _probe_config = SERIAL_8N1;
+  _baud = 0;
+  _config = SERIAL_8N1;
+  _rx = -1;
+  _tx = -1;
+  memset(_line, 0, sizeof(_line));
+  _timeout = MODBUS_RESPONSE_TIMEOUT;
+  _probe_timeout = 0;
+  _rx_count = 0;
+  _error = MODBUS_OK;
+  _exception = 0;
+  _task = NULL;
+  _queue = NULL;
+  _urgent_queue = NULL;
+  _running_priority = MODBUS_PRIORITY_COUNT;
+  memset(_request_cache, 0, sizeof(_request_cache));
+  memset(_snapshot, 0, sizeof(_snapshot));
+  _snapshot_ttl = MODBUS_SNAPSHOT_TTL;
+  memset(_latency, 0, sizeof(_latency));
+  _adaptive = true;
+  _timeout_floor = MODBUS_TIMEOUT_FLOOR;
+  _timeout_ceiling = MODBUS_TIMEOUT_CEILING;
+  _answer_us = 0;
+  _metrics_enable = true;
+  resetMetrics();
+}
+
+/***********************************************************************
+ * FUNCTION:    port
+ * DESCRIPTION: Serial port of this bus
+ * PARAMETERS:  nothing
+ * RETURNED:    HardwareSerial
+ ***********************************************************************/
+HardwareSerial &tiny32_ModbusMaster::port(void)
+{
+  return _port;
+}
+
+/***********************************************************************
+ * FUNCTION:    begin
+ * DESCRIPTION: Start serial port of this bus, line setting of the first
+ *              begin is the default of the bus. Begin again (next driver on
+ *              the same bus) don't change the default, device with other
+ *              setting is added by setDeviceLine/ useLine and the port is
+ *              switched only when next device need it
+ * PARAMETERS:  baud, config(SERIAL_8N1, SERIAL_8N2, ..), rx, tx
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::begin(uint32_t baud, uint32_t config, int8_t rx, int8_t tx)
+{
+  lock();
+  if (_default_baud != 0)
+  {
+    unlock();
+    return; // started already, line of other device is kept by device
+  }
+  _port.begin(baud, config, rx, tx);
+  _default_baud = baud;
+  _default_config = config;
+  _baud = baud;
+  _config = config;
+  _rx = rx;
+  _tx = tx;
+  unlock();
+}
+
+/***********************************************************************
+ * FUNCTION:    setDeviceLine
+ * DESCRIPTION: Line setting of one device when it is not the default
+ *              setting of begin (e.g. PZEM-003 9600 8N2, PR-3000 4800 8N1)
+ * PARAMETERS:  id, baud(0 = use default), config(SERIAL_8N1, SERIAL_8N2, ..)
+ * RETURNED:    true/ false(table is full)
+ ***********************************************************************/
+bool tiny32_ModbusMaster::setDeviceLine(uint8_t id, uint32_t baud, uint32_t config)
+{
+  tiny32_ModbusLine *_free = NULL;
+
+  for (uint8_t _i = 0; _i < MODBUS_LINE_MAX; _i++)
+  {
+    if ((_line[_i].baud != 0) && (_line[_i].id == id))
+    {
+      _line[_i].baud = baud; // baud 0 => remove
+      _line[_i].config = config;
+      return true;
+    }
+    if ((_line[_i].baud == 0) && (_free == NULL))
+      _free = &_line[_i];
+  }
+
+  if (baud == 0)
+    return true;
+
+  if (_free == NULL)
+  {
+    Serial.printf("Error: device line setting is full[%d]\r\n", MODBUS_LINE_MAX);
+    return false;
+  }
+
+  _free->id = id;
+  _free->baud = baud;
+  _free->config = config;
+  return true;
+}
+
+/***********************************************************************
+ * FUNCTION:    useLine
+ * DESCRIPTION: Line setting that device driver know for id, kept only when
+ *              id has no own setting (setDeviceLine of user is not changed)
+ *              and it is not the default setting of begin
+ * PARAMETERS:  id, baud, config(SERIAL_8N1, SERIAL_8N2, ..)
+ * RETURNED:    true/ false(table is full)
+ ***********************************************************************/
+bool tiny32_ModbusMaster::useLine(uint8_t id, uint32_t baud, uint32_t config)
+{
+  bool _success = true;
+
+  for (uint8_t _i = 0; _i < MODBUS_LINE_MAX; _i++)
+  {
+    if ((_line[_i].baud != 0) && (_line[_i].id == id))
+      return true;
+  }
+  if ((_default_baud == 0) || ((baud == _default_baud) && (config == _default_config)))
+    return true;
+
+  lock(); // table is read by bus task
+  _success = setDeviceLine(id, baud, config);
+  unlock();
+  return _success;
+}
+
+/***********************************************************************
+ * FUNCTION:    deviceLine
+ * DESCRIPTION: Line setting that is used for id
+ * PARAMETERS:  id, baud(out), config(out)
+ * RETURNED:    true/ false(line is not managed, begin was not called)
+ ***********************************************************************/
+bool tiny32_ModbusMaster::deviceLine(uint8_t id, uint32_t &baud, uint32_t &config)
+{
+  baud = (_probe_baud != 0) ? _probe_baud : _default_baud; // searchAddress of driver with other line
+  config = (_probe_baud != 0) ? _probe_config : _default_config;
+
+  for (uint8_t _i = 0; _i < MODBUS_LINE_MAX; _i++)
+  {
+    if ((_line[_i].baud != 0) && (_line[_i].id == id))
+    {
+      baud = _line[_i].baud;
+      config = _line[_i].config;
+      break;
+    }
+  }
+
+  return _default_baud != 0;
+}
+
+/***********************************************************************
+ * FUNCTION:    sameLine
+ * DESCRIPTION: Device can be polled without switching the port
+ * PARAMETERS:  id
+ * RETURNED:    true/ false
+ ***********************************************************************/
+bool tiny32_ModbusMaster::sameLine(uint8_t id)
+{
+  uint32_t _baud_id, _config_id;
+
+  if (!deviceLine(id, _baud_id, _config_id))
+    return true;
+
+  return (_baud_id == _baud) && (_config_id == _config);
+}
+
+/***********************************************************************
+ * FUNCTION:    applyLine
+ * DESCRIPTION: Switch the port to line setting of id (only baud rate =>
+ *              updateBaudRate, parity/ stop bit => begin again)
+ * PARAMETERS:  id
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::applyLine(uint8_t id)
+{
+  uint32_t _baud_id, _config_id;
+
+  if (!deviceLine(id, _baud_id, _config_id) || ((_baud_id == _baud) && (_config_id == _config)))
+    return;
+
+  uint32_t _start = micros();
+  if (_config_id == _config)
+    _port.updateBaudRate(_baud_id);
+  else
+    _port.begin(_baud_id, _config_id, _rx, _tx);
+  _baud = _baud_id;
+  _config = _config_id;
+
+  uint32_t _time = micros() - _start;
+  _line_switch_count++;
+  _line_switch_us += _time;
+  if (_time > _line_switch_max_us)
+    _line_switch_max_us = _time;
+}
+
+/***********************************************************************
+ * FUNCTION:    lineSwitchCount
+ * DESCRIPTION: Number of port switch since resetMetrics
+ * PARAMETERS:  nothing
+ * RETURNED:    switch
+ ***********************************************************************/
+uint32_t tiny32_ModbusMaster::lineSwitchCount(void)
+{
+  return _line_switch_count;
+}
+
+/***********************************************************************
+ * FUNCTION:    busId
+ * DESCRIPTION: Number of this bus (frame capture)
+ * PARAMETERS:  nothing
+ * RETURNED:    bus id
+ ***********************************************************************/
+uint8_t tiny32_ModbusMaster::busId(void)
+{
+  return _bus_id;
+}
+
+/***********************************************************************
+ * FUNCTION:    setTimeout
+ * DESCRIPTION: Set maximum wait for a ModbusRTU response
+ * PARAMETERS:  timeout_ms
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::setTimeout(uint16_t timeout_ms)
+{
+  _timeout = timeout_ms;
+}
+
+/***********************************************************************
+ * FUNCTION:    getTimeout
+ * DESCRIPTION: Get maximum wait for a ModbusRTU response
+ * PARAMETERS:  nothing
+ * RETURNED:    timeout_ms
+ ***********************************************************************/
+uint16_t tiny32_ModbusMaster::getTimeout(void)
+{
+  return _timeout;
+}
+
+/***********************************************************************
+ * FUNCTION:    setAdaptiveTimeout
+ * DESCRIPTION: Learn answer time of each device and wait only as long as
+ *              that device need (timeout of setTimeout is used until the
+ *              device was learned)
+ * PARAMETERS:  enable, floor_ms(minimum), ceiling_ms(maximum after error)
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::setAdaptiveTimeout(bool enable, uint16_t floor_ms, uint16_t ceiling_ms)
+{
+  _adaptive = enable;
+  _timeout_floor = floor_ms;
+  _timeout_ceiling = (ceiling_ms < floor_ms) ? floor_ms : ceiling_ms;
+}
+
+/***********************************************************************
+ * FUNCTION:    deviceTimeout
+ * DESCRIPTION: Answer timeout that is used for id
+ * PARAMETERS:  id
+ * RETURNED:    timeout_ms
+ ***********************************************************************/
+uint16_t tiny32_ModbusMaster::deviceTimeout(uint8_t id)
+{
+  if (_adaptive)
+  {
+    tiny32_ModbusLatency *_l = latency(id);
+    if ((_l != NULL) && (_l->timeout_ms != 0))
+      return _l->timeout_ms;
+  }
+
+  return (_probe_timeout != 0) ? _probe_timeout : _timeout;
+}
+
+/***********************************************************************
+ * FUNCTION:    latency
+ * DESCRIPTION: Learned answer time of id
+ * PARAMETERS:  id
+ * RETURNED:    tiny32_ModbusLatency, NULL = device was never answer
+ ***********************************************************************/
+tiny32_ModbusLatency *tiny32_ModbusMaster::latency(uint8_t id)
+{
+  for (uint8_t _i = 0; _i < MODBUS_LATENCY_MAX; _i++)
+  {
+    if ((_latency[_i].id == id) && (_latency[_i].timeout_ms != 0))
+      return &_latency[_i];
+  }
+
+  return NULL;
+}
+
+/***********************************************************************
+ * FUNCTION:    clearLatency
+ * DESCRIPTION: Forget learned answer time of all device
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::clearLatency(void)
+{
+  memset(_latency, 0, sizeof(_latency));
+}
+
+/***********************************************************************
+ * FUNCTION:    learn
+ * DESCRIPTION: Update answer time of id after a transaction (same as TCP
+ *              retransmit timer: smoothed answer time + 4 x deviation).
+ *              No response from learned device => double timeout (up to
+ *              ceiling) and learn again from the next answer
+ * PARAMETERS:  id, result of transaction
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::learn(uint8_t id, uint8_t result)
+{
+  if (id == 0)
+    return; // broadcast
+
+  tiny32_ModbusLatency *_l = latency(id);
+
+  if ((result == MODBUS_ERROR_TIMEOUT) || (result == MODBUS_ERROR_LENGTH))
+  {
+    if (_l == NULL)
+      return; // never answer, keep timeout of setTimeout
+
+    _l->timeout_count++;
+    _l->sample_count = 0; // learn again
+    uint32_t _backoff = (uint32_t)deviceTimeout(id) * 2;
+    _l->timeout_ms = (_backoff > _timeout_ceiling) ? _timeout_ceiling : _backoff;
+    return;
+  }
+
+  if (_answer_us == 0)
+    return; // no answer time (e.g. parameter error)
+
+  if (_l == NULL)
+  {
+    /*** new device: empty or the least used entry ***/
+    _l = &_latency[0];
+    for (uint8_t _i = 1; (_l->timeout_ms != 0) && (_i < MODBUS_LATENCY_MAX); _i++)
+    {
+      if ((_latency[_i].timeout_ms == 0) || (_latency[_i].answer_count < _l->answer_count))
+        _l = &_latency[_i];
+    }
+    memset(_l, 0, sizeof(tiny32_ModbusLatency));
+    _l->id = id;
+  }
+
+  uint32_t _sample = _answer_us;
+  if (_l->sample_count == 0)
+  {
+    _l->average_us = _sample;
+    _l->deviation_us = _sample / 2;
+  }
+  else
+  {
+    uint32_t _diff = (_sample > _l->average_us) ? (_sample - _l->average_us) : (_l->average_us - _sample);
+    _l->deviation_us = (_l->deviation_us * 3 + _diff) / 4; // beta = 1/4
+    _l->average_us = (_l->average_us * 7 + _sample) / 8;   // alpha = 1/8
+  }
+  if (_sample > _l->max_us)
+    _l->max_us = _sample;
+  if (_l->sample_count < 0xFFFF)
+    _l->sample_count++;
+  _l->answer_count++;
+
+  if (_l->sample_count >= MODBUS_LATENCY_SAMPLE)
+  {
+    uint32_t _timeout_ms = (_l->average_us + (_l->deviation_us * 4) + 999) / 1000 + MODBUS_TIMEOUT_MARGIN;
+    _l->timeout_ms = constrain(_timeout_ms, (uint32_t)_timeout_floor, (uint32_t)_timeout_ceiling);
+  }
+  else if (_l->timeout_ms == 0)
+  {
+    _l->timeout_ms = _timeout; // answer seen, not learned yet (configured timeout, not the probe timeout)
+  }
+}
+
+/***********************************************************************
+ * FUNCTION:    printLatency
+ * DESCRIPTION: Print out learned answer time and timeout of all device
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::printLatency(void)
+{
+  Serial.printf("\r\n id  average[mS]  deviation[mS]  max[mS]  timeout[mS]  answer  no answer\r\n");
+  for (uint8_t _i = 0; _i < MODBUS_LATENCY_MAX; _i++)
+  {
+    tiny32_ModbusLatency *_l = &_latency[_i];
+    if (_l->timeout_ms == 0)
+      continue;
+    Serial.printf("%3d  %11.1f  %13.1f  %7.1f  %11d  %6d  %9d\r\n", _l->id, _l->average_us / 1000.0, _l->deviation_us / 1000.0,
+                  _l->max_us / 1000.0, _l->timeout_ms, _l->answer_count, _l->timeout_count);
+  }
+  Serial.printf("default timeout: %d mS, adaptive: %s [%d-%d mS]\r\n", _timeout, _adaptive ? "on" : "off", _timeout_floor, _timeout_ceiling);
+}
+
+/***********************************************************************
+ * FUNCTION:    setMetrics
+ * DESCRIPTION: Enable/ disable counting of transaction (metrics)
+ * PARAMETERS:  enable
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::setMetrics(bool enable)
+{
+  _metrics_enable = enable;
+}
+
+/***********************************************************************
+ * FUNCTION:    resetMetrics
+ * DESCRIPTION: Clear metrics of bus and all device
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::resetMetrics(void)
+{
+  memset(&_metrics, 0, sizeof(_metrics));
+  memset(_device_metrics, 0, sizeof(_device_metrics));
+  memset(&_contention, 0, sizeof(_contention));
+  _line_switch_count = 0;
+  _line_switch_us = 0;
+  _line_switch_max_us = 0;
+  _metrics_start_ms = millis();
+}
+
+/***********************************************************************
+ * FUNCTION:    metrics
+ * DESCRIPTION: Metrics of bus (id = 0) or one device
+ * PARAMETERS:  id
+ * RETURNED:    tiny32_ModbusMetrics, NULL = no transaction to id
+ ***********************************************************************/
+const tiny32_ModbusMetrics *tiny32_ModbusMaster::metrics(uint8_t id)
+{
+  if (id == 0)
+    return &_metrics;
+
+  for (uint8_t _i = 0; _i < MODBUS_METRICS_DEVICE_MAX; _i++)
+  {
+    if ((_device_metrics[_i].id == id) && (_device_metrics[_i].transaction != 0))
+      return &_device_metrics[_i];
+  }
+
+  return NULL;
+}
+
+/***********************************************************************
+ * FUNCTION:    occupancy
+ * DESCRIPTION: Part of time that bus was in transaction since resetMetrics
+ * PARAMETERS:  nothing
+ * RETURNED:    0.0 - 1.0
+ ***********************************************************************/
+float tiny32_ModbusMaster::occupancy(void)
+{
+  uint32_t _elapsed = millis() - _metrics_start_ms;
+
+  if (_elapsed == 0)
+    return 0;
+
+  return (_metrics.busy_us / 1000.0) / _elapsed;
+}
+
+/***********************************************************************
+ * FUNCTION:    histogramBin
+ * DESCRIPTION: Latency bin of transaction time, bin 0 < 1 mS, bin n <
+ *              2^n mS, the last bin is everything slower
+ * PARAMETERS:  time_us
+ * RETURNED:    bin [0 - MODBUS_HISTOGRAM_BIN-1]
+ ***********************************************************************/
+uint8_t tiny32_ModbusMaster::histogramBin(uint32_t time_us)
+{
+  uint32_t _ms = time_us / 1000;
+  uint8_t _bin = 0;
+
+  while ((_ms > 0) && (_bin < MODBUS_HISTOGRAM_BIN - 1))
+  {
+    _ms >>= 1;
+    _bin++;
+  }
+
+  return _bin;
+}
+
+/***********************************************************************
+ * FUNCTION:    record
+ * DESCRIPTION: Count transaction to metrics of bus and device
+ * PARAMETERS:  id, request length, result, time_us
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::record(uint8_t id, uint8_t request_len, uint8_t result, uint32_t time_us)
+{
+  tiny32_ModbusMetrics *_d = NULL;
+  uint8_t _bin = histogramBin(time_us);
+
+  for (uint8_t _i = 0; _i < MODBUS_METRICS_DEVICE_MAX; _i++)
+  {
+    if (_device_metrics[_i].transaction == 0)
+    {
+      if (_d == NULL)
+        _d = &_device_metrics[_i]; // first free entry
+    }
+    else if (_device_metrics[_i].id == id)
+    {
+      _d = &_device_metrics[_i];
+      break;
+    }
+  }
+
+  tiny32_ModbusMetrics *_m[2] = {&_metrics, _d}; // device table full => bus only
+  for (uint8_t _i = 0; (_i < 2) && (_m[_i] != NULL); _i++)
+  {
+    _m[_i]->id = (_i == 0) ? 0 : id;
+    _m[_i]->transaction++;
+    if (result < MODBUS_ERROR_COUNT)
+      _m[_i]->result[result]++;
+    _m[_i]->tx_byte += request_len;
+    _m[_i]->rx_byte += _rx_count;
+    _m[_i]->busy_us += time_us;
+    if (time_us > _m[_i]->max_us)
+      _m[_i]->max_us = time_us;
+    _m[_i]->histogram[_bin]++;
+  }
+}
+
+/***********************************************************************
+ * FUNCTION:    metricsJSON
+ * DESCRIPTION: Metrics of bus and all device as JSON
+ *              {"elapsed_ms":,"occupancy":,"bus":{..},"device":[{..},..]}
+ * PARAMETERS:  json buffer, size
+ * RETURNED:    length of json, 0 = buffer too small
+ ***********************************************************************/
+uint16_t tiny32_ModbusMaster::metricsJSON(char *json, uint16_t size)
+{
+  static const char *_result_name[MODBUS_ERROR_COUNT] = {"success", "timeout", "incomplete", "crc", "id_error", "function_error", "exception", "parameter_error"};
+  int _len = snprintf(json, size, "{\"elapsed_ms\":%u,\"occupancy\":%.4f,\"contention\":{\"lock\":%u,\"wait\":%u,\"wait_ms\":%.1f,\"wait_max_ms\":%.1f,\"timeout\":%u,"
+                                  "\"queue\":[%u,%u],\"queue_ms\":[%.1f,%.1f],\"queue_max_ms\":[%.1f,%.1f],\"inversion\":%u,\"inversion_ms\":%.1f,\"inversion_max_ms\":%.1f},"
+                                  "\"line_switch\":%u,\"line_switch_ms\":%.2f,\"line_switch_max_ms\":%.2f,\"bus\":",
+                      (unsigned)(millis() - _metrics_start_ms), occupancy(), (unsigned)_contention.lock_count, (unsigned)_contention.contended_count,
+                      _contention.wait_us / 1000.0, _contention.wait_max_us / 1000.0, (unsigned)_contention.timeout_count,
+                      (unsigned)_contention.queue_count[MODBUS_PRIORITY_NORMAL], (unsigned)_contention.queue_count[MODBUS_PRIORITY_URGENT],
+                      _contention.queue_wait_us[MODBUS_PRIORITY_NORMAL] / 1000.0, _contention.queue_wait_us[MODBUS_PRIORITY_URGENT] / 1000.0,
+                      _contention.queue_max_us[MODBUS_PRIORITY_NORMAL] / 1000.0, _contention.queue_max_us[MODBUS_PRIORITY_URGENT] / 1000.0,
+                      (unsigned)_contention.inversion_count, _contention.inversion_us / 1000.0, _contention.inversion_max_us / 1000.0,
+                      (unsigned)_line_switch_count, _line_switch_us / 1000.0, _line_switch_max_us / 1000.0);
+  bool _first_device = true;
+
+  for (int16_t _i = -1; (_i < MODBUS_METRICS_DEVICE_MAX) && (_len > 0) && (_len < size); _i++)
+  {
+    tiny32_ModbusMetrics *_m = (_i < 0) ? &_metrics : &_device_metrics[_i];
+    if ((_i >= 0) && (_m->transaction == 0))
+      continue;
+
+    if (_i >= 0)
+    {
+      _len += snprintf(&json[_len], size - _len, _first_device ? ",\"device\":[" : ",");
+      _first_device = false;
+      if (_len >= size)
+        break;
+    }
+
+    _len += snprintf(&json[_len], size - _len, "{\"id\":%d,\"transaction\":%u,\"tx_byte\":%u,\"rx_byte\":%u,\"busy_ms\":%u,\"max_ms\":%.1f",
+                     _m->id, (unsigned)_m->transaction, (unsigned)_m->tx_byte, (unsigned)_m->rx_byte, (unsigned)(_m->busy_us / 1000), _m->max_us / 1000.0);
+    for (uint8_t _r = 0; (_r < MODBUS_ERROR_COUNT) && (_len < size); _r++)
+      _len += snprintf(&json[_len], size - _len, ",\"%s\":%u", _result_name[_r], (unsigned)_m->result[_r]);
+    for (uint8_t _b = 0; (_b < MODBUS_HISTOGRAM_BIN) && (_len < size); _b++)
+      _len += snprintf(&json[_len], size - _len, (_b == 0) ? ",\"histogram_ms\":[%u" : ",%u", (unsigned)_m->histogram[_b]);
+    if (_len < size)
+      _len += snprintf(&json[_len], size - _len, "]}");
+  }
+
+  if ((_len > 0) && (_len < size))
+    _len += snprintf(&json[_len], size - _len, _first_device ? "}" : "]}");
+
+  if ((_len <= 0) || (_len >= size))
+  {
+    Serial.printf("Error: metrics json buffer is too small[%d]\r\n", size);
+    if (size > 0)
+      json[0] = 0;
+    return 0;
+  }
+
+  return _len;
+}
+
+/***********************************************************************
+ * FUNCTION:    printMetrics
+ * DESCRIPTION: Print out metrics of bus and all device
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::printMetrics(void)
+{
+  Serial.printf("\r\n id  transaction  success  timeout  incomplete  crc  id/fc  exception  avg[mS]  max[mS]  busy[mS]   tx[byte]   rx[byte]\r\n");
+  for (int16_t _i = -1; _i < MODBUS_METRICS_DEVICE_MAX; _i++)
+  {
+    tiny32_ModbusMetrics *_m = (_i < 0) ? &_metrics : &_device_metrics[_i];
+    if ((_i >= 0) && (_m->transaction == 0))
+      continue;
+
+    Serial.printf((_i < 0) ? "bus" : "%3d", _m->id);
+    Serial.printf("  %11u  %7u  %7u  %10u  %3u  %5u  %9u  %7.1f  %7.1f  %8u  %9u  %9u\r\n", (unsigned)_m->transaction, (unsigned)_m->result[MODBUS_OK],
+                  (unsigned)_m->result[MODBUS_ERROR_TIMEOUT], (unsigned)_m->result[MODBUS_ERROR_LENGTH], (unsigned)_m->result[MODBUS_ERROR_CRC],
+                  (unsigned)(_m->result[MODBUS_ERROR_ID] + _m->result[MODBUS_ERROR_FUNCTION]), (unsigned)_m->result[MODBUS_ERROR_EXCEPTION],
+                  _m->transaction ? (_m->busy_us / 1000.0) / _m->transaction : 0.0, _m->max_us / 1000.0, (unsigned)(_m->busy_us / 1000),
+                  (unsigned)_m->tx_byte, (unsigned)_m->rx_byte);
+  }
+  Serial.printf("bus occupancy: %.1f%% of %u mS\r\n", occupancy() * 100, (unsigned)(millis() - _metrics_start_ms));
+  Serial.printf("bus lock: %u (%u wait, avg %.2f mS, max %.2f mS, %u timeout)\r\n", (unsigned)_contention.lock_count, (unsigned)_contention.contended_count,
+                _contention.contended_count ? (_contention.wait_us / 1000.0) / _contention.contended_count : 0.0, _contention.wait_max_us / 1000.0,
+                (unsigned)_contention.timeout_count);
+  for (uint8_t _p = 0; _p < MODBUS_PRIORITY_COUNT; _p++)
+  {
+    Serial.printf("%s queue: %u job (avg %.2f mS, max %.2f mS)\r\n", (_p == MODBUS_PRIORITY_URGENT) ? "urgent" : "normal", (unsigned)_contention.queue_count[_p],
+                  _contention.queue_count[_p] ? (_contention.queue_wait_us[_p] / 1000.0) / _contention.queue_count[_p] : 0.0, _contention.queue_max_us[_p] / 1000.0);
+  }
+  Serial.printf("line switch: %u (total %.2f mS, max %.2f mS)\r\n", (unsigned)_line_switch_count, _line_switch_us / 1000.0, _line_switch_max_us / 1000.0);
+  Serial.printf("priority inversion: %u (avg %.2f mS, max %.2f mS behind normal job)\r\n", (unsigned)_contention.inversion_count,
+                _contention.inversion_count ? (_contention.inversion_us / 1000.0) / _contention.inversion_count : 0.0, _contention.inversion_max_us / 1000.0);
+}
+
+/***********************************************************************
+ * FUNCTION:    crc16_update
+ * DESCRIPTION: CRC16 check, bit by bit (reference of crc16 table)
+ * PARAMETERS:  uint16_t crc, uint8_t a
+ * RETURNED:    uint16_t
+ ***********************************************************************/
+uint16_t tiny32_ModbusMaster::crc16_update(uint16_t crc, uint8_t a)
+{
+  int i;
+
+  crc ^= a;
+  for (i = 0; i < 8; ++i)
+  {
+    if (crc & 1)
+      crc = (crc >> 1) ^ 0xA001;
+    else
+      crc = (crc >> 1);
+  }
+
+  return crc;
+}
+
+/***********************************************************************
+ * FUNCTION:    crc16
+ * DESCRIPTION: CRC16 of data buffer (table lookup, 1 step per byte)
+ * PARAMETERS:  data, len
+ * RETURNED:    uint16_t
+ ***********************************************************************/
+uint16_t tiny32_ModbusMaster::crc16(const uint8_t *data, uint16_t len)
+{
+  uint16_t _crc = 0xffff;
+
+  for (uint16_t _i = 0; _i < len; _i++)
+    _crc = (_crc >> 8) ^ _crc16_table[(_crc ^ data[_i]) & 0xff];
+
+  return _crc;
+}
+
+/***********************************************************************
+ * FUNCTION:    appendCRC
+ * DESCRIPTION: Insert CRC16 to frame[len] and frame[len + 1] (low byte first)
+ * PARAMETERS:  frame, len
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::appendCRC(uint8_t *frame, uint8_t len)
+{
+  uint16_t _crc = crc16(frame, len);
+
+  frame[len] = _crc & 0xff;
+  frame[len + 1] = _crc >> 8;
+}
+
+/***********************************************************************
+ * FUNCTION:    request
+ * DESCRIPTION: Build 8 byte request [id fc addrH addrL valueH valueL crcL crcH]
+ * PARAMETERS:  frame, id, function, address, value(quantity)
+ * RETURNED:    frame length
+ ***********************************************************************/
+uint8_t tiny32_ModbusMaster::request(uint8_t *frame, uint8_t id, uint8_t function, uint16_t address, uint16_t value)
+{
+  frame[0] = id;
+  frame[1] = function;
+  frame[2] = address >> 8;
+  frame[3] = address & 0xff;
+  frame[4] = value >> 8;
+  frame[5] = value & 0xff;
+  appendCRC(frame, 6);
+
+  return 8;
+}
+
+/***********************************************************************
+ * FUNCTION:    cachedRequest
+ * DESCRIPTION: Same as request() but reuse the CRC16 of a frame that was
+ *              already sent (polling repeat the same frame for each id)
+ * PARAMETERS:  frame, id, function, address, value(quantity)
+ * RETURNED:    frame length
+ ***********************************************************************/
+uint8_t tiny32_ModbusMaster::cachedRequest(uint8_t *frame, uint8_t id, uint8_t function, uint16_t address, uint16_t value)
+{
+  uint8_t *_entry = _request_cache[(id ^ function ^ address ^ (address >> 8) ^ value) % MODBUS_REQUEST_CACHE];
+
+  frame[0] = id;
+  frame[1] = function;
+  frame[2] = address >> 8;
+  frame[3] = address & 0xff;
+  frame[4] = value >> 8;
+  frame[5] = value & 0xff;
+
+  if ((_entry[1] != 0) && (memcmp(_entry, frame, 6) == 0))
+  {
+    frame[6] = _entry[6];
+    frame[7] = _entry[7];
+    return 8;
+  }
+
+  appendCRC(frame, 6);
+  memcpy(_entry, frame, 8);
+  return 8;
+}
+
+/***********************************************************************
+ * FUNCTION:    responseLength
+ * DESCRIPTION: Expected response length from function code and quantity
+ * PARAMETERS:  request frame, request length
+ * RETURNED:    number of byte (include CRC16)
+ ***********************************************************************/
+uint16_t tiny32_ModbusMaster::responseLength(const uint8_t *request, uint8_t request_len)
+{
+  if (request_len < 6)
+    return request_len;
+
+  uint16_t _quantity = ((uint16_t)request[4] << 8) | request[5];
+
+  switch (request[1])
+  {
+  case 0x01: // read coils
+  case 0x02: // read discrete inputs
+    return 5 + ((_quantity + 7) / 8);
+  case 0x03: // read holding registers
+  case 0x04: // read input registers
+    return 5 + (_quantity * 2);
+  case 0x05: // write single coil
+  case 0x06: // write single register
+  case 0x0F: // write multiple coils
+  case 0x10: // write multiple registers
+    return 8;
+  default: // vendor function (e.g. PZEM 0x42 reset) answer with an echo
+    return request_len;
+  }
+}
+
+/***********************************************************************
+ * FUNCTION:    silence_us
+ * DESCRIPTION: ModbusRTU t3.5 inter-frame silence
+ * PARAMETERS:  baud rate
+ * RETURNED:    microsecond
+ ***********************************************************************/
+uint32_t tiny32_ModbusMaster::silence_us(uint32_t baud)
+{
+  if (baud == 0 || baud > 19200)
+    return 1750; // fixed value recommended by Modbus over serial line spec
+
+  return 38500000UL / baud; // 3.5 character x 11 bit
+}
+
+/***********************************************************************
+ * FUNCTION:    findFrame
+ * DESCRIPTION: Streaming frame assembler, slide over received byte and
+ *              accept the first window that is [id fc] of request (or
+ *              [id fc|0x80] exception), has plausible length (byte count
+ *              of FC01-FC04 read, 5 byte exception) and correct CRC16.
+ *              Noise/ echo before and after the frame is skipped.
+ *              scan keep position between call, window that can't be a
+ *              frame anymore is not checked again
+ * PARAMETERS:  data, len, request, response_len, scan(in/out), frame_len(out)
+ * RETURNED:    index of frame, -1 = no valid frame (yet)
+ ***********************************************************************/
+int16_t tiny32_ModbusMaster::findFrame(const uint8_t *data, uint16_t len, const uint8_t *request, uint16_t response_len, uint16_t *scan, uint16_t *frame_len)
+{
+  bool _pending = false; // a window before is not complete yet
+
+  for (uint16_t _k = *scan; _k + 1 < len; _k++)
+  {
+    bool _dead = true;
+
+    if ((data[_k] == request[0]) && ((data[_k + 1] & 0x7F) == request[1]))
+    {
+      bool _exception = (data[_k + 1] & 0x80) != 0;
+      uint16_t _len = _exception ? 5 : response_len;
+      bool _read = !_exception && (request[1] >= 0x01) && (request[1] <= 0x04);
+
+      if (_read && (_k + 2 < len) && (data[_k + 2] != (uint8_t)(response_len - 5)))
+        _dead = true; // byte count is not plausible
+      else if (_k + _len > len)
+        _dead = false; // wait for more byte
+      else if (crc16(&data[_k], _len) == 0)
+      {
+        *frame_len = _len;
+        return _k;
+      }
+    }
+
+    if (!_dead)
+      _pending = true;
+    else if (!_pending)
+      *scan = _k + 1;
+  }
+
+  return -1;
+}
+
+/***********************************************************************
+ * FUNCTION:    receive
+ * DESCRIPTION: Collect response while it arrive and stop as soon as:
+ *              - exception frame with correct CRC16 was found
+ *              - response frame with correct CRC16 was found and t3.5
+ *                silence passed
+ *              - frame of other id/function with correct CRC16 was found
+ *                and t3.5 silence passed (noise only wait until timeout)
+ *              timeout is the answer time of slave, the time to receive
+ *              the expected frame is added on top
+ * PARAMETERS:  request frame, request length, response buffer, response_len
+ * RETURNED:    MODBUS_OK or MODBUS_ERROR_xxx
+ ***********************************************************************/
+uint8_t tiny32_ModbusMaster::receive(const uint8_t *request, uint8_t request_len, uint8_t *response, uint16_t response_len)
+{
+  uint8_t _data_read[MODBUS_FRAME_MAX];
+  uint16_t _byte_cnt = 0;
+  uint16_t _scan = 0;  // first window that may still be the frame
+  int16_t _frame = -1; // index of valid frame
+  uint16_t _frame_len = 0;
+  uint32_t _silence = silence_us(_port.baudRate());
+  uint32_t _char_us = 11000000UL / (_port.baudRate() ? _port.baudRate() : 9600);
+  uint8_t _result = MODBUS_ERROR_TIMEOUT;
+
+  _port.flush(); // wait until request was sent out completely
+  uint32_t _start = micros();
+  uint32_t _last_rx = _start;
+  uint32_t _deadline = ((uint32_t)deviceTimeout(request[0]) * 1000) + (response_len * _char_us); // answer time + frame time
+  _answer_us = 0;
+
+  while ((micros() - _start) < _deadline)
+  {
+    bool _new = false;
+    while (_port.available() > 0)
+    {
+      uint8_t _byte = _port.read(); // leading 0x00/0xFF glitch of line is skipped by findFrame
+
+      if ((_byte_cnt == sizeof(_data_read)) && (_scan > 0) && (_frame < 0))
+      {
+        memmove(_data_read, &_data_read[_scan], _byte_cnt - _scan); // drop noise, keep window
+        _byte_cnt -= _scan;
+        _scan = 0;
+      }
+      if (_byte_cnt < sizeof(_data_read))
+        _data_read[_byte_cnt++] = _byte;
+      _new = true;
+    }
+    if (_new)
+    {
+      _last_rx = micros();
+      if (_answer_us == 0)
+        _answer_us = _last_rx - _start; // first byte
+
+      if (_frame < 0)
+        _frame = findFrame(_data_read, _byte_cnt, request, response_len, &_scan, &_frame_len);
+    }
+
+    if ((_frame >= 0) && (_data_read[_frame + 1] & 0x80))
+      break; // exception, no need to wait
+
+    if (!_new && ((micros() - _last_rx) >= _silence))
+    {
+      if (_frame >= 0)
+        break;
+      if (foreignFrame(_data_read, _byte_cnt, request) >= 0)
+        break; // frame of other id/function with correct CRC16 was ended
+    }
+    vTaskDelay(1);
+  }
+
+  debugFrame("Data read", _data_read, _byte_cnt);
+  _rx_count = _byte_cnt;
+  _exception = 0;
+
+  if (_frame >= 0)
+  {
+    if (_data_read[_frame + 1] & 0x80)
+    {
+      _exception = _data_read[_frame + 2];
+      _result = MODBUS_ERROR_EXCEPTION;
+    }
+    else
+    {
+      memcpy(response, &_data_read[_frame], response_len);
+      debugFrame("Data check", response, response_len);
+      _result = MODBUS_OK;
+    }
+  }
+  else if (_byte_cnt > 0)
+  {
+    int16_t _head = header(_data_read, _byte_cnt, request);
+    int16_t _foreign = (_head < 0) ? foreignFrame(_data_read, _byte_cnt, request) : -1;
+    if (_foreign >= 0)
+      _result = (_data_read[_foreign] != request[0]) ? MODBUS_ERROR_ID : MODBUS_ERROR_FUNCTION;
+    else if (_head < 0)
+      _result = MODBUS_ERROR_CRC; // noise only, no frame with correct CRC16
+    else if (_byte_cnt - _head >= ((_data_read[_head + 1] & 0x80) ? 5 : response_len))
+      _result = MODBUS_ERROR_CRC; // complete length but no window with correct CRC16
+    else
+      _result = MODBUS_ERROR_LENGTH;
+  }
+
+  if (modbus_capture.enabled())
+    modbus_capture.record(_bus_id, MODBUS_CAPTURE_RX, _result, _byte_cnt ? _start + _answer_us : micros(), _data_read, _byte_cnt);
+
+  return _result;
+}
+
+/***********************************************************************
+ * FUNCTION:    header
+ * DESCRIPTION: First [id fc] or [id fc|0x80] of request in received byte
+ * PARAMETERS:  data, len, request
+ * RETURNED:    index, -1 = not found
+ ***********************************************************************/
+int16_t tiny32_ModbusMaster::header(const uint8_t *data, uint16_t len, const uint8_t *request)
+{
+  for (uint16_t _k = 0; _k + 1 < len; _k++)
+  {
+    if ((data[_k] == request[0]) && ((data[_k + 1] & 0x7F) == request[1]))
+      return _k;
+  }
+
+  return -1;
+}
+
+/***********************************************************************
+ * FUNCTION:    foreignFrame
+ * DESCRIPTION: First response frame with correct CRC16 that is not [id fc]
+ *              of request (exception, byte count of FC01-FC04 read, 8 byte
+ *              echo of FC05/06/15/16 write)
+ * PARAMETERS:  data, len, request
+ * RETURNED:    index, -1 = not found
+ ***********************************************************************/
+int16_t tiny32_ModbusMaster::foreignFrame(const uint8_t *data, uint16_t len, const uint8_t *request)
+{
+  for (uint16_t _k = 0; _k + 1 < len; _k++)
+  {
+    uint8_t _function = data[_k + 1];
+    uint16_t _len;
+
+    if ((data[_k] == request[0]) && ((_function & 0x7F) == request[1]))
+      continue;
+
+    if (_function & 0x80)
+      _len = 5;
+    else if ((_function >= 0x01) && (_function <= 0x04) && (_k + 2 < len))
+      _len = data[_k + 2] + 5;
+    else if ((_function == 0x05) || (_function == 0x06) || (_function == 0x0F) || (_function == 0x10))
+      _len = 8;
+    else
+      continue;
+
+    if ((_k + _len <= len) && (crc16(&data[_k], _len) == 0))
+      return _k;
+  }
+
+  return -1;
+}
+
+/***********************************************************************
+ * FUNCTION:    debugFrame
+ * DESCRIPTION: Print out frame in hex (modbusRTU_Debug only)
+ * PARAMETERS:  title, frame, len
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::debugFrame(const char *title, const uint8_t *frame, uint16_t len)
+{
+#ifdef modbusRTU_Debug
+  Serial.printf("%s(%d): [ ", title, len);
+  for (uint16_t _i = 0; _i < len; _i++)
+    Serial.printf("0x%02X ", frame[_i]);
+  Serial.printf("]\r\n");
+#endif
+}
+
+/***********************************************************************
+ * FUNCTION:    exchange
+ * DESCRIPTION: Send request and collect a CRC checked response (on the bus)
+ * PARAMETERS:  request, request_len, response buffer, response_len, quiet(no error print)
+ * RETURNED:    true/ false (reason in lastError/lastException)
+ ***********************************************************************/
+bool tiny32_ModbusMaster::exchange(const uint8_t *request, uint8_t request_len, uint8_t *response, uint16_t response_len, bool quiet)
+{
+  debugFrame("Data write", request, request_len);
+
+  /**** Write data ****/
+  _port.flush();
+  applyLine(request[0]);
+  while (_port.available() > 0)
+    _port.read(); // late answer of previous request
+  uint32_t _start = micros();
+  _port.write(request, request_len);
+  if (modbus_capture.enabled())
+    modbus_capture.record(_bus_id, MODBUS_CAPTURE_TX, MODBUS_OK, _start, request, request_len);
+
+  _error = receive(request, request_len, response, response_len);
+  learn(request[0], _error);
+  if (_metrics_enable)
+    record(request[0], request_len, _error, micros() - _start);
+
+  if ((_error != MODBUS_OK) && !quiet)
+  {
+    switch (_error)
+    {
+    case MODBUS_ERROR_CRC:
+      Serial.printf("Error: crc16\r\n");
+      break;
+    case MODBUS_ERROR_EXCEPTION:
+      Serial.printf("Error: exception 0x%02X (%s)\r\n", _exception, exceptionString(_exception));
+      break;
+    case MODBUS_ERROR_ID:
+    case MODBUS_ERROR_FUNCTION:
+      Serial.printf("Error: %s\r\n", errorString(_error));
+      break;
+    default:
+      Serial.printf("Error: data error\r\n");
+      break;
+    }
+  }
+
+  return _error == MODBUS_OK;
+}
+
+/***********************************************************************
+ * FUNCTION:    lastError
+ * DESCRIPTION: Result of the last transaction
+ * PARAMETERS:  nothing
+ * RETURNED:    MODBUS_OK or MODBUS_ERROR_xxx
+ ***********************************************************************/
+uint8_t tiny32_ModbusMaster::lastError(void)
+{
+  return _error;
+}
+
+/***********************************************************************
+ * FUNCTION:    lastException
+ * DESCRIPTION: Exception code of the last transaction
+ * PARAMETERS:  nothing
+ * RETURNED:    exception code, 0 = no exception
+ ***********************************************************************/
+uint8_t tiny32_ModbusMaster::lastException(void)
+{
+  return _exception;
+}
+
+/***********************************************************************
+ * FUNCTION:    errorString
+ * DESCRIPTION: Text of MODBUS_ERROR_xxx
+ * PARAMETERS:  error
+ * RETURNED:    text
+ ***********************************************************************/
+const char *tiny32_ModbusMaster::errorString(uint8_t error)
+{
+  switch (error)
+  {
+  case MODBUS_OK:
+    return "success";
+  case MODBUS_ERROR_TIMEOUT:
+    return "no response";
+  case MODBUS_ERROR_LENGTH:
+    return "incomplete response";
+  case MODBUS_ERROR_CRC:
+    return "crc16 error";
+  case MODBUS_ERROR_ID:
+    return "response from other id";
+  case MODBUS_ERROR_FUNCTION:
+    return "response of other function code";
+  case MODBUS_ERROR_EXCEPTION:
+    return "exception response";
+  case MODBUS_ERROR_PARAMETER:
+    return "parameter out of the range";
+  default:
+    return "unknown error";
+  }
+}
+
+/***********************************************************************
+ * FUNCTION:    exceptionString
+ * DESCRIPTION: Text of ModbusRTU exception code
+ * PARAMETERS:  exception code
+ * RETURNED:    text
+ ***********************************************************************/
+const char *tiny32_ModbusMaster::exceptionString(uint8_t exception)
+{
+  switch (exception)
+  {
+  case 0x01:
+    return "illegal function";
+  case 0x02:
+    return "illegal data address";
+  case 0x03:
+    return "illegal data value";
+  case 0x04:
+    return "slave device failure";
+  case 0x05:
+    return "acknowledge";
+  case 0x06:
+    return "slave device busy";
+  case 0x08:
+    return "memory parity error";
+  case 0x0A:
+    return "gateway path unavailable";
+  case 0x0B:
+    return "gateway target device failed to respond";
+  default:
+    return "unknown exception";
+  }
+}
+
+/***********************************************************************
+ * FUNCTION:    transaction
+ * DESCRIPTION: Send request and collect a CRC checked response
+ * PARAMETERS:  request, request_len, response buffer, response_len, quiet(no error print)
+ * RETURNED:    true/ false
+ ***********************************************************************/
+bool tiny32_ModbusMaster::transaction(const uint8_t *request, uint8_t request_len, uint8_t *response, uint16_t response_len, bool quiet)
+{
+  tiny32_ModbusJob _job;
+
+  clearSnapshot(request[0]); // e.g. reset energy
+  _job.id = request[0];
+  _job.function = request[1];
+  _job.frame = request;
+  _job.frame_len = request_len;
+  _job.data = response;
+  _job.data_len = response_len;
+  _job.quiet = quiet;
+  _job.priority = MODBUS_PRIORITY_URGENT; // e.g. reset energy, set address
+  return run(&_job);
+}
+
+/***********************************************************************
+ * FUNCTION:    readRegisters
+ * DESCRIPTION: Read register block with function code 0x03/0x04 (on demand
+ *              read, urgent lane)
+ * PARAMETERS:  id, function, address, quantity, data(quantity x 2 byte), quiet
+ * RETURNED:    true/ false
+ ***********************************************************************/
+bool tiny32_ModbusMaster::readRegisters(uint8_t id, uint8_t function, uint16_t address, uint16_t quantity, uint8_t *data, bool quiet)
+{
+  tiny32_ModbusJob _job;
+
+  _job.priority = MODBUS_PRIORITY_URGENT;
+  _job.id = id;
+  _job.function = function;
+  _job.address = address;
+  _job.value = quantity;
+  _job.data = data;
+  _job.data_len = quantity * 2;
+  _job.quiet = quiet;
+  return run(&_job);
+}
+
+/***********************************************************************
+ * FUNCTION:    writeRegister
+ * DESCRIPTION: Write single register with function code 0x06
+ * PARAMETERS:  id, address, value
+ * RETURNED:    true/ false
+ ***********************************************************************/
+bool tiny32_ModbusMaster::writeRegister(uint8_t id, uint16_t address, uint16_t value)
+{
+  tiny32_ModbusJob _job;
+
+  clearSnapshot(id);
+  _job.priority = MODBUS_PRIORITY_URGENT;
+  _job.id = id;
+  _job.function = 0x06;
+  _job.address = address;
+  _job.value = value;
+  return run(&_job);
+}
+
+/***********************************************************************
+ * FUNCTION:    searchAddress
+ * DESCRIPTION: Search the first address that answer the read request, id
+ *              without own line setting is probed with line of the driver
+ *              and the found id keep it (useLine)
+ * PARAMETERS:  function, address, quantity, first id, last id, device name,
+ *              baud(0 = default line of begin), config
+ * RETURNED:    Address, -1 = not found
+ ***********************************************************************/
+int16_t tiny32_ModbusMaster::searchAddress(uint8_t function, uint16_t address, uint16_t quantity, uint8_t first, uint8_t last, const char *name,
+                                           uint32_t baud, uint32_t config)
+{
+  tiny32_ModbusSignature _signature = {function, address, quantity, name};
+  tiny32_ModbusDevice _found;
+  uint8_t _count;
+
+  lock();
+  _probe_baud = baud;
+  _probe_config = config;
+  _count = discover(&_signature, 1, first, last, &_found, 1);
+  _probe_baud = 0;
+  if ((_count > 0) && (baud != 0))
+    useLine(_found.id, baud, config);
+  unlock();
+
+  if (_count > 0)
+  {
+    Serial.printf("\r\nInfo: the Address of this %s => %d [Success]\r\n", name, _found.id);
+    return _found.id;
+  }
+
+  Serial.printf("\r\nInfo: Finish searching .... Can't find %s for this bus [fail]", name);
+  return -1;
+}
+
+/***********************************************************************
+ * FUNCTION:    discover
+ * DESCRIPTION: Probe every id with the signature list and return all id
+ *              that answer (in id order). Probe timeout = 2 x slowest answer
+ *              time seen so far (start from MODBUS_PROBE_LATENCY), a probe
+ *              that receive part of frame is repeated with full timeout and
+ *              the answer time is learned. An id that keep silent to the
+ *              short probe is probed again in the last pass with 3 x the
+ *              slowest answer time (full timeout when thorough, slow device
+ *              behind a fast one is not lost but every empty id cost the
+ *              full timeout). An id that keep silent to the first signature
+ *              is skipped (probe_all = true to try every signature, for
+ *              device that not answer unknown register)
+ * PARAMETERS:  signature list, signature_count, first id, last id,
+ *              found(list of result), found_max, probe_all, thorough
+ * RETURNED:    number of device found
+ ***********************************************************************/
+uint8_t tiny32_ModbusMaster::discover(const tiny32_ModbusSignature *signature, uint8_t signature_count, uint8_t first, uint8_t last,
+                                      tiny32_ModbusDevice *found, uint8_t found_max, bool probe_all, bool thorough)
+{
+  lock(); // own the bus for whole scan, probe timeout is not used by other task
+  uint8_t _data[MODBUS_REGISTER_MAX * 2];
+  uint8_t _silent[32]; // bit of id that keep silent to the short probe
+  uint32_t _char_us = 11000000UL / (_port.baudRate() ? _port.baudRate() : 9600);
+  uint32_t _latency_us = MODBUS_PROBE_LATENCY * 1000UL;
+  uint16_t _probe_max = 0; // the longest short probe timeout
+  uint16_t _rescan = 0;    // timeout of the last pass
+  uint8_t _found = 0;
+
+  memset(_silent, 0, sizeof(_silent));
+
+  for (uint8_t _pass = 0; _pass < 2; _pass++)
+  {
+    if (_pass == 1)
+    {
+      _rescan = thorough ? _timeout : constrain((3 * _latency_us) / 1000 + 1, MODBUS_PROBE_TIMEOUT_MIN, _timeout);
+      if (_rescan <= _probe_max)
+        break; // no longer wait than the short probe, nothing to find
+    }
+
+    for (uint16_t _id = first; (_id <= last) && (_found < found_max); _id++)
+    {
+      if ((_pass == 1) && !((_silent[_id >> 3] >> (_id & 7)) & 1))
+        continue; // answered or was probed with full timeout already
+
+      for (uint8_t _s = 0; _s < signature_count; _s++)
+      {
+        const tiny32_ModbusSignature *_sig = &signature[_s];
+        uint32_t _frame_us = (8 + 5 + (_sig->quantity * 2)) * _char_us;
+        uint32_t _probe_ms = (2 * _latency_us) / 1000 + 1;
+
+        _probe_timeout = (_pass == 0) ? constrain(_probe_ms, MODBUS_PROBE_TIMEOUT_MIN, _timeout) : _rescan;
+        if ((_pass == 0) && (_probe_timeout > _probe_max))
+          _probe_max = _probe_timeout;
+        uint32_t _start = micros();
+        bool _success = readRegisters(_id, _sig->function, _sig->address, _sig->quantity, _data, true);
+
+        if (!_success && (_error == MODBUS_ERROR_LENGTH) && (_probe_timeout < _timeout))
+        {
+          _probe_timeout = _timeout; // part of frame => slow device, wait fully
+          _start = micros();
+          _success = readRegisters(_id, _sig->function, _sig->address, _sig->quantity, _data, true);
+        }
+        uint32_t _elapsed = micros() - _start;
+
+        if (_success)
+        {
+          if (_elapsed > _frame_us)
+          {
+            if (_found == 0)
+              _latency_us = _elapsed - _frame_us; // first device, replace the guess
+            else if ((_elapsed - _frame_us) > _latency_us)
+              _latency_us = _elapsed - _frame_us; // learn the slowest device
+          }
+
+          uint8_t _i = _found++;
+          for (; (_i > 0) && (found[_i - 1].id > _id); _i--)
+            found[_i] = found[_i - 1]; // id of the last pass is put in order
+          found[_i].id = _id;
+          found[_i].signature = _s;
+          found[_i].response_ms = _elapsed / 1000;
+          break;
+        }
+
+        if (_error == MODBUS_ERROR_TIMEOUT)
+        {
+          if ((_pass == 0) && (_probe_timeout < _timeout))
+            _silent[_id >> 3] |= 1 << (_id & 7); // may be slow device, not absence
+          if (!probe_all)
+            break; // nobody at this id (for this pass)
+        }
+      }
+    }
+  }
+
+  _probe_timeout = 0;
+  unlock();
+  return _found;
+}
+
+/***********************************************************************
+ * FUNCTION:    lastRxCount
+ * DESCRIPTION: Number of byte received by the last transaction
+ * PARAMETERS:  nothing
+ * RETURNED:    byte
+ ***********************************************************************/
+uint16_t tiny32_ModbusMaster::lastRxCount(void)
+{
+  return _rx_count;
+}
+
+/***********************************************************************
+ * FUNCTION:    readSnapshot
+ * DESCRIPTION: Same as readRegisters() but the block read within TTL is
+ *              served from snapshot cache (getters of one device share one
+ *              transaction), block > MODBUS_SNAPSHOT_REGISTER is not cached
+ * PARAMETERS:  id, function, address, quantity, data(quantity x 2 byte), quiet,
+ *              time_ms(millis() of the device read that data come from)
+ * RETURNED:    true/ false
+ ***********************************************************************/
+bool tiny32_ModbusMaster::readSnapshot(uint8_t id, uint8_t function, uint16_t address, uint16_t quantity, uint8_t *data, bool quiet, uint32_t *time_ms)
+{
+  tiny32_ModbusSnapshot *_entry;
+
+  if (time_ms != NULL)
+    *time_ms = millis();
+  if ((_snapshot_ttl == 0) || (quantity > MODBUS_SNAPSHOT_REGISTER))
+    return readRegisters(id, function, address, quantity, data, quiet);
+
+  portENTER_CRITICAL(&_snapshot_mux);
+  _entry = snapshotSlot(id, function, address, quantity, false);
+  if ((_entry != NULL) && ((millis() - _entry->time_ms) < _snapshot_ttl))
+  {
+    memcpy(data, _entry->data, quantity * 2);
+    if (time_ms != NULL)
+      *time_ms = _entry->time_ms;
+    portEXIT_CRITICAL(&_snapshot_mux);
+    return true;
+  }
+  portEXIT_CRITICAL(&_snapshot_mux);
+
+  if (!readRegisters(id, function, address, quantity, data, quiet))
+    return false;
+
+  portENTER_CRITICAL(&_snapshot_mux); // slot is chosen again, other task may fill/ clear it during the read
+  _entry = snapshotSlot(id, function, address, quantity, true);
+  _entry->id = id;
+  _entry->function = function;
+  _entry->address = address;
+  _entry->quantity = quantity;
+  _entry->time_ms = millis();
+  memcpy(_entry->data, data, quantity * 2);
+  if (time_ms != NULL)
+    *time_ms = _entry->time_ms; // the same time as the later cache hit
+  portEXIT_CRITICAL(&_snapshot_mux);
+
+  return true;
+}
+
+/***********************************************************************
+ * FUNCTION:    snapshotSlot
+ * DESCRIPTION: Snapshot of block (_snapshot_mux is taken by caller)
+ * PARAMETERS:  id, function, address, quantity, oldest (true = give the
+ *              free/ oldest slot when block is not there)
+ * RETURNED:    snapshot, NULL = not found
+ ***********************************************************************/
+tiny32_ModbusSnapshot *tiny32_ModbusMaster::snapshotSlot(uint8_t id, uint8_t function, uint16_t address, uint16_t quantity, bool oldest)
+{
+  tiny32_ModbusSnapshot *_oldest = &_snapshot[0];
+
+  for (uint8_t _i = 0; _i < MODBUS_SNAPSHOT_MAX; _i++)
+  {
+    tiny32_ModbusSnapshot *_s = &_snapshot[_i];
+    if ((_s->function == function) && (_s->id == id) && (_s->address == address) && (_s->quantity == quantity))
+      return _s;
+    if ((_s->function == 0) || ((_oldest->function != 0) && ((int32_t)(_s->time_ms - _oldest->time_ms) < 0)))
+      _oldest = _s;
+  }
+
+  return oldest ? _oldest : NULL;
+}
+
+/***********************************************************************
+ * FUNCTION:    setSnapshotTTL
+ * DESCRIPTION: Set time-to-live of snapshot cache
+ * PARAMETERS:  ttl_ms (0 = no cache, every read go to the bus)
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::setSnapshotTTL(uint16_t ttl_ms)
+{
+  _snapshot_ttl = ttl_ms;
+}
+
+/***********************************************************************
+ * FUNCTION:    getSnapshotTTL
+ * DESCRIPTION: Get time-to-live of snapshot cache
+ * PARAMETERS:  nothing
+ * RETURNED:    ttl_ms
+ ***********************************************************************/
+uint16_t tiny32_ModbusMaster::getSnapshotTTL(void)
+{
+  return _snapshot_ttl;
+}
+
+/***********************************************************************
+ * FUNCTION:    clearSnapshot
+ * DESCRIPTION: Remove snapshot of id (after write to the device)
+ * PARAMETERS:  id
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::clearSnapshot(uint8_t id)
+{
+  portENTER_CRITICAL(&_snapshot_mux);
+  for (uint8_t _i = 0; _i < MODBUS_SNAPSHOT_MAX; _i++)
+  {
+    if (_snapshot[_i].id == id)
+      _snapshot[_i].function = 0;
+  }
+  portEXIT_CRITICAL(&_snapshot_mux);
+}
+
+/***********************************************************************
+ * FUNCTION:    execute
+ * DESCRIPTION: Do the job on the bus (caller task or bus task)
+ * PARAMETERS:  job
+ * RETURNED:    true/ false
+ ***********************************************************************/
+bool tiny32_ModbusMaster::execute(tiny32_ModbusJob *job)
+{
+  uint8_t _data_write[8];
+  uint8_t _data_check[MODBUS_FRAME_MAX];
+  bool _success = false;
+
+  if (job->frame != NULL)
+  {
+    _success = exchange(job->frame, job->frame_len, job->data, job->data_len, job->quiet);
+  }
+  else if ((job->function == 0x03) || (job->function == 0x04))
+  {
+    if ((job->value == 0) || (job->value > MODBUS_REGISTER_MAX))
+    {
+      Serial.printf("Error: register quantity is out of the range[1-%d]\r\n", MODBUS_REGISTER_MAX);
+      _error = MODBUS_ERROR_PARAMETER;
+      _exception = 0;
+    }
+    else
+    {
+      cachedRequest(_data_write, job->id, job->function, job->address, job->value);
+      _success = exchange(_data_write, sizeof(_data_write), _data_check, 5 + (job->value * 2), job->quiet);
+      if (_success)
+        memcpy(job->data, &_data_check[3], job->value * 2);
+    }
+  }
+  else if (job->function == 0x06)
+  {
+    cachedRequest(_data_write, job->id, 0x06, job->address, job->value);
+    _success = exchange(_data_write, sizeof(_data_write), _data_check, sizeof(_data_write), job->quiet);
+  }
+  else
+  {
+    Serial.printf("Error: function code 0x%02X is not support\r\n", job->function);
+    _error = MODBUS_ERROR_PARAMETER;
+    _exception = 0;
+  }
+
+  job->error = _error;
+  job->exception = _exception;
+
+  // blocking caller may leave as soon as status change, keep what we need first
+  modbus_callback_t _callback = job->callback;
+  TaskHandle_t _notify = job->notify;
+
+  job->status = _success ? MODBUS_JOB_SUCCESS : MODBUS_JOB_FAIL;
+  if (_callback != NULL)
+    _callback(job);
+  if (_notify != NULL)
+    xTaskNotifyGive(_notify);
+
+  return _success;
+}
+
+/***********************************************************************
+ * FUNCTION:    run
+ * DESCRIPTION: Blocking call of job, pass to bus task when it was started
+ * PARAMETERS:  job
+ * RETURNED:    true/ false
+ ***********************************************************************/
+bool tiny32_ModbusMaster::run(tiny32_ModbusJob *job)
+{
+  TaskHandle_t _self = xTaskGetCurrentTaskHandle();
+
+  if ((_task == NULL) || (_self == _task) || (xSemaphoreGetMutexHolder(_mutex) == _self))
+  {
+    /*** no bus task, call from callback or caller own the bus => do on this task ***/
+    lock();
+    bool _success = execute(job);
+    unlock();
+    return _success;
+  }
+
+  job->notify = _self;
+  if (!submit(job))
+    return false;
+
+  return job->wait();
+}
+
+/***********************************************************************
+ * FUNCTION:    lock
+ * DESCRIPTION: Own the bus (recursive mutex with priority inheritance, a
+ *              low priority owner run at priority of the highest waiting
+ *              task). Use to keep several transaction together, e.g.
+ *              write then read back, every transaction take it itself
+ * PARAMETERS:  timeout_ms (portMAX_DELAY = forever)
+ * RETURNED:    true/ false(timeout)
+ ***********************************************************************/
+bool tiny32_ModbusMaster::lock(uint32_t timeout_ms)
+{
+  if (xSemaphoreTakeRecursive(_mutex, 0) != pdTRUE)
+  {
+    uint32_t _start = micros();
+    if (xSemaphoreTakeRecursive(_mutex, (timeout_ms == portMAX_DELAY) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms)) != pdTRUE)
+    {
+      _contention.timeout_count++;
+      return false;
+    }
+
+    uint32_t _wait = micros() - _start;
+    _contention.contended_count++;
+    _contention.wait_us += _wait;
+    if (_wait > _contention.wait_max_us)
+      _contention.wait_max_us = _wait;
+  }
+  _contention.lock_count++;
+
+  return true;
+}
+
+/***********************************************************************
+ * FUNCTION:    unlock
+ * DESCRIPTION: Release the bus (one unlock for each lock)
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::unlock(void)
+{
+  xSemaphoreGiveRecursive(_mutex);
+}
+
+/***********************************************************************
+ * FUNCTION:    contention
+ * DESCRIPTION: Wait time of task for the bus (since resetMetrics)
+ * PARAMETERS:  nothing
+ * RETURNED:    tiny32_ModbusContention
+ ***********************************************************************/
+const tiny32_ModbusContention *tiny32_ModbusMaster::contention(void)
+{
+  return &_contention;
+}
+
+/***********************************************************************
+ * FUNCTION:    beginTask
+ * DESCRIPTION: Start bus task to serve job queue, all blocking call of this
+ *              bus are passed to bus task after this. Urgent job (write and
+ *              blocking call) is served before normal job (poll, readAsync)
+ * PARAMETERS:  priority, core, queue_size
+ * RETURNED:    true/ false
+ ***********************************************************************/
+bool tiny32_ModbusMaster::beginTask(UBaseType_t priority, BaseType_t core, uint8_t queue_size)
+{
+  if (_task != NULL)
+    return true;
+
+  _queue = xQueueCreate(queue_size, sizeof(tiny32_ModbusJob *));
+  _urgent_queue = xQueueCreate(queue_size, sizeof(tiny32_ModbusJob *));
+  if ((_queue == NULL) || (_urgent_queue == NULL))
+  {
+    Serial.printf("Error: can't create ModbusRTU queue\r\n");
+    return false;
+  }
+
+  if (xTaskCreatePinnedToCore(busTask, "modbus_bus", 4096, this, priority, &_task, core) != pdPASS)
+  {
+    Serial.printf("Error: can't create ModbusRTU bus task\r\n");
+    _task = NULL;
+    return false;
+  }
+
+  return true;
+}
+
+/***********************************************************************
+ * FUNCTION:    taskRunning
+ * DESCRIPTION: Bus task was started
+ * PARAMETERS:  nothing
+ * RETURNED:    true/ false
+ ***********************************************************************/
+bool tiny32_ModbusMaster::taskRunning(void)
+{
+  return _task != NULL;
+}
+
+/***********************************************************************
+ * FUNCTION:    submit
+ * DESCRIPTION: Put job to queue of bus task (return immediately)
+ * PARAMETERS:  job
+ * RETURNED:    true/ false(no bus task or queue full)
+ ***********************************************************************/
+bool tiny32_ModbusMaster::submit(tiny32_ModbusJob *job)
+{
+  if (_queue == NULL)
+  {
+    Serial.printf("Error: ModbusRTU bus task is not started (beginTask)\r\n");
+    return false;
+  }
+
+  if (job->priority >= MODBUS_PRIORITY_COUNT)
+    job->priority = MODBUS_PRIORITY_URGENT;
+
+  job->status = MODBUS_JOB_PENDING;
+  job->submit_us = micros();
+  job->inversion = (job->priority == MODBUS_PRIORITY_URGENT) && (_running_priority == MODBUS_PRIORITY_NORMAL);
+  if (xQueueSend((job->priority == MODBUS_PRIORITY_URGENT) ? _urgent_queue : _queue, &job, 0) != pdTRUE)
+  {
+    job->status = MODBUS_JOB_FAIL;
+    Serial.printf("Error: ModbusRTU queue is full\r\n");
+    return false;
+  }
+  xTaskNotifyGive(_task); // one count for each job
+
+  return true;
+}
+
+/***********************************************************************
+ * FUNCTION:    readAsync
+ * DESCRIPTION: Queue read register job (function code 0x03/0x04)
+ * PARAMETERS:  job, id, function, address, quantity, data(quantity x 2 byte), callback, arg,
+ *              priority(MODBUS_PRIORITY_NORMAL = background poll)
+ * RETURNED:    true/ false
+ ***********************************************************************/
+bool tiny32_ModbusMaster::readAsync(tiny32_ModbusJob *job, uint8_t id, uint8_t function, uint16_t address, uint16_t quantity, uint8_t *data, modbus_callback_t callback, void *arg, uint8_t priority)
+{
+  *job = tiny32_ModbusJob();
+  job->priority = priority;
+  job->id = id;
+  job->function = function;
+  job->address = address;
+  job->value = quantity;
+  job->data = data;
+  job->data_len = quantity * 2;
+  job->callback = callback;
+  job->arg = arg;
+  return submit(job);
+}
+
+/***********************************************************************
+ * FUNCTION:    writeAsync
+ * DESCRIPTION: Queue write single register job (function code 0x06), urgent
+ *              lane so it is sent before queued poll
+ * PARAMETERS:  job, id, address, value, callback, arg
+ * RETURNED:    true/ false
+ ***********************************************************************/
+bool tiny32_ModbusMaster::writeAsync(tiny32_ModbusJob *job, uint8_t id, uint16_t address, uint16_t value, modbus_callback_t callback, void *arg)
+{
+  *job = tiny32_ModbusJob();
+  clearSnapshot(id);
+  job->priority = MODBUS_PRIORITY_URGENT;
+  job->id = id;
+  job->function = 0x06;
+  job->address = address;
+  job->value = value;
+  job->callback = callback;
+  job->arg = arg;
+  return submit(job);
+}
+
+/***********************************************************************
+ * FUNCTION:    busTask
+ * DESCRIPTION: FreeRTOS task, do job from queue one by one
+ * PARAMETERS:  tiny32_ModbusMaster
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusMaster::busTask(void *arg)
+{
+  tiny32_ModbusMaster *_bus = (tiny32_ModbusMaster *)arg;
+  tiny32_ModbusJob *_job;
+
+  for (;;)
+  {
+    ulTaskNotifyTake(pdFALSE, portMAX_DELAY); // wait for submit
+
+    /*** urgent lane first, normal job wait while urgent job is queued ***/
+    if ((xQueueReceive(_bus->_urgent_queue, &_job, 0) != pdTRUE) && (xQueueReceive(_bus->_queue, &_job, 0) != pdTRUE))
+      continue;
+
+    _bus->lock();
+    uint8_t _priority = _job->priority;
+    uint32_t _wait = micros() - _job->submit_us;
+    tiny32_ModbusContention *_c = &_bus->_contention;
+    _c->queue_count[_priority]++;
+    _c->queue_wait_us[_priority] += _wait;
+    if (_wait > _c->queue_max_us[_priority])
+      _c->queue_max_us[_priority] = _wait;
+    if (_job->inversion)
+    {
+      _c->inversion_count++; // urgent job had to wait for normal job on the bus
+      _c->inversion_us += _wait;
+      if (_wait > _c->inversion_max_us)
+        _c->inversion_max_us = _wait;
+    }
+
+    _bus->_running_priority = _priority;
+    _bus->execute(_job);
+    _bus->_running_priority = MODBUS_PRIORITY_COUNT;
+    _bus->unlock();
+  }
+}
+
+/***********************************************************************
+ * FUNCTION:    tiny32_ModbusJob
+ * DESCRIPTION: Empty job
+ ***********************************************************************/
+tiny32_ModbusJob::tiny32_ModbusJob(void)
+{
+  id = 0;
+  function = 0;
+  address = 0;
+  value = 0;
+  error = MODBUS_OK;
+  exception = 0;
+  data = NULL;
+  data_len = 0;
+  frame = NULL;
+  frame_len = 0;
+  quiet = false;
+  callback = NULL;
+  arg = NULL;
+  notify = NULL;
+  submit_us = 0;
+  priority = MODBUS_PRIORITY_NORMAL;
+  inversion = false;
+  status = MODBUS_JOB_IDLE;
+}
+
+/***********************************************************************
+ * FUNCTION:    done
+ * DESCRIPTION: Job was finished (success or fail)
+ * PARAMETERS:  nothing
+ * RETURNED:    true/ false
+ ***********************************************************************/
+bool tiny32_ModbusJob::done(void)
+{
+  return (status == MODBUS_JOB_SUCCESS) || (status == MODBUS_JOB_FAIL);
+}
+
+/***********************************************************************
+ * FUNCTION:    success
+ * DESCRIPTION: Job was finished with CRC checked response
+ * PARAMETERS:  nothing
+ * RETURNED:    true/ false
+ ***********************************************************************/
+bool tiny32_ModbusJob::success(void)
+{
+  return status == MODBUS_JOB_SUCCESS;
+}
+
+/***********************************************************************
+ * FUNCTION:    wait
+ * DESCRIPTION: Wait until job finish (future), use task notification if
+ *              notify is this task otherwise poll every 1 mS
+ * PARAMETERS:  timeout_ms (portMAX_DELAY = forever)
+ * RETURNED:    true = success, false = fail or timeout
+ ***********************************************************************/
+bool tiny32_ModbusJob::wait(uint32_t timeout_ms)
+{
+  TickType_t _start = xTaskGetTickCount();
+  bool _notify = (notify == xTaskGetCurrentTaskHandle());
+
+  while (!done())
+  {
+    if ((timeout_ms != portMAX_DELAY) && ((xTaskGetTickCount() - _start) >= pdMS_TO_TICKS(timeout_ms)))
+      return false;
+
+    if (_notify)
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+    else
+      vTaskDelay(1);
+  }
+
+  return success();
+}
+
+/***********************************************************************
+ * FUNCTION:    toUint16
+ * DESCRIPTION: Decode 16 bit register
+ * PARAMETERS:  data
+ * RETURNED:    uint16_t
+ ***********************************************************************/
+uint16_t tiny32_ModbusMaster::toUint16(const uint8_t *data)
+{
+  return tiny32_ModbusUint16<>::raw(data);
+}
+
+/***********************************************************************
+ * FUNCTION:    toInt16
+ * DESCRIPTION: Decode signed 16 bit register
+ * PARAMETERS:  data
+ * RETURNED:    int16_t
+ ***********************************************************************/
+int16_t tiny32_ModbusMaster::toInt16(const uint8_t *data)
+{
+  return tiny32_ModbusInt16<>::raw(data);
+}
+
+/***********************************************************************
+ * FUNCTION:    toUint32
+ * DESCRIPTION: Decode 32 bit value, high word first [ABCD]
+ * PARAMETERS:  data
+ * RETURNED:    uint32_t
+ ***********************************************************************/
+uint32_t tiny32_ModbusMaster::toUint32(const uint8_t *data)
+{
+  return tiny32_ModbusUint32<MODBUS_ORDER_ABCD>::raw(data);
+}
+
+/***********************************************************************
+ * FUNCTION:    toUint32_CDAB
+ * DESCRIPTION: Decode 32 bit value, low word first [CDAB] (PZEM)
+ * PARAMETERS:  data
+ * RETURNED:    uint32_t
+ ***********************************************************************/
+uint32_t tiny32_ModbusMaster::toUint32_CDAB(const uint8_t *data)
+{
+  return tiny32_ModbusUint32<MODBUS_ORDER_CDAB>::raw(data);
+}
+
+/***********************************************************************
+ * FUNCTION:    toFloat
+ * DESCRIPTION: Decode IEEE754 float, high word first [ABCD]
+ * PARAMETERS:  data
+ * RETURNED:    float
+ ***********************************************************************/
+float tiny32_ModbusMaster::toFloat(const uint8_t *data)
+{
+  return tiny32_ModbusFloat<MODBUS_ORDER_ABCD>::raw(data);
+}
+
+/***********************************************************************
+ * FUNCTION:    toFloat_CDAB
+ * DESCRIPTION: Decode IEEE754 float, low word first [CDAB] (tiny32 ModbusRTU)
+ * PARAMETERS:  data
+ * RETURNED:    float
+ ***********************************************************************/
+float tiny32_ModbusMaster::toFloat_CDAB(const uint8_t *data)
+{
+  return tiny32_ModbusFloat<MODBUS_ORDER_CDAB>::raw(data);
+}
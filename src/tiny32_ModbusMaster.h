@@ -0,0 +1,360 @@
+/***********************************************************************
+ * File         :     tiny32_ModbusMaster.h
+ * Description  :     ModbusRTU master engine (request builder, response
+ *                    parser and register decoder) for tiny32_v3 module
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17 Oct 2026
+ * Revision     :     2.3
+ * Rev1.0       :     Original
+ * Rev1.1       :     Table driven CRC16 and cache of request CRC16
+ * Rev1.2       :     Asynchronous request queue served by bus task (callback, notify, wait)
+ * Rev1.3       :     Discovery of all device on the bus with short adaptive probe timeout
+ * Rev1.4       :     Snapshot cache of register block with time-to-live
+ * Rev1.5       :     Fail fast on exception and other id/function response, report reason
+ * Rev1.6       :     Adaptive timeout, learn answer time of each device
+ * Rev1.7       :     Metrics of bus and device (result counter, latency histogram, byte, occupancy, JSON)
+ * Rev1.8       :     Runtime frame capture (tiny32_ModbusCapture)
+ * Rev1.9       :     Streaming frame resync with CRC16 sliding window (findFrame)
+ * Rev2.0       :     Bus mutex with priority inheritance (lock/unlock) and contention metrics
+ * Rev2.1       :     Priority lane of bus task, urgent write/ on demand read before background poll
+ * Rev2.2       :     Line setting of each device, switch the port only when needed
+ * Rev2.3       :     Register decoder use compile time template of tiny32_ModbusDecode.h
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     089-140-7205
+ ***********************************************************************/
+
+#ifndef TINY32_MODBUSMASTER_H
+#define TINY32_MODBUSMASTER_H
+#include "Arduino.h"
+#include "tiny32_ModbusCapture.h"
+#include "tiny32_ModbusDecode.h"
+
+/**************************************/
+/*        ModbusRTU define            */
+/**************************************/
+#define MODBUS_RESPONSE_TIMEOUT 300 // mS, maximum answer time of slave (+ frame time)
+#define MODBUS_FRAME_MAX 256        // maximum ModbusRTU ADU size
+#define MODBUS_REGISTER_MAX 125     // maximum register for one read request
+#define MODBUS_REQUEST_CACHE 16     // number of request frame that keep CRC16
+#define MODBUS_QUEUE_SIZE 16        // default number of job waiting for bus task
+#define MODBUS_PROBE_LATENCY 25     // mS, first guess of slave answer time for discovery probe
+#define MODBUS_PROBE_TIMEOUT_MIN 20 // mS, minimum discovery probe timeout
+#define MODBUS_SNAPSHOT_MAX 8       // number of register block in snapshot cache (each bus)
+#define MODBUS_SNAPSHOT_REGISTER 16 // maximum register of one cached block
+#define MODBUS_SNAPSHOT_TTL 500     // mS, default time-to-live of snapshot (0 = no cache)
+#define MODBUS_LATENCY_MAX 32       // number of device that answer time is learned (each bus)
+#define MODBUS_LATENCY_SAMPLE 4     // answer before learned timeout is used
+#define MODBUS_TIMEOUT_FLOOR 10     // mS, default minimum learned timeout
+#define MODBUS_TIMEOUT_CEILING 1000 // mS, default maximum timeout after no answer
+#define MODBUS_TIMEOUT_MARGIN 5     // mS, add to learned timeout (task tick)
+#define MODBUS_METRICS_DEVICE_MAX 32 // number of device that has own metrics (each bus)
+#define MODBUS_HISTOGRAM_BIN 12      // latency bin <1, <2, <4 .. <1024 mS, >=1024 mS
+#define MODBUS_LINE_MAX 16           // number of device with own line setting (each bus)
+
+/**************************************/
+/*        ModbusRTU error code        */
+/**************************************/
+#define MODBUS_OK 0
+#define MODBUS_ERROR_TIMEOUT 1   // no response
+#define MODBUS_ERROR_LENGTH 2    // part of frame
+#define MODBUS_ERROR_CRC 3       // crc16 error
+#define MODBUS_ERROR_ID 4        // response from other id
+#define MODBUS_ERROR_FUNCTION 5  // response of other function code
+#define MODBUS_ERROR_EXCEPTION 6 // exception response (code in lastException)
+#define MODBUS_ERROR_PARAMETER 7 // request parameter out of the range
+#define MODBUS_ERROR_COUNT 8     // number of result code (metrics)
+
+/**************************************/
+/*        ModbusRTU job status        */
+/**************************************/
+#define MODBUS_JOB_IDLE 0
+#define MODBUS_JOB_PENDING 1
+#define MODBUS_JOB_SUCCESS 2
+#define MODBUS_JOB_FAIL 3
+
+/**************************************/
+/*        ModbusRTU job priority      */
+/**************************************/
+#define MODBUS_PRIORITY_NORMAL 0 // background poll (scheduler, readAsync)
+#define MODBUS_PRIORITY_URGENT 1 // write and on demand (blocking) read
+#define MODBUS_PRIORITY_COUNT 2
+
+/**************************************/
+/*   ModbusRTU discovery signature    */
+/**************************************/
+/*  read request that only one device type answer, e.g. {0x04, 0x0046, 2, "SDM630MCT"} */
+struct tiny32_ModbusSignature
+{
+    uint8_t function;
+    uint16_t address;
+    uint16_t quantity;
+    const char *name;
+};
+
+struct tiny32_ModbusDevice
+{
+    uint8_t id;
+    uint8_t signature;    // index of signature that device answer
+    uint16_t response_ms; // time of the probe transaction
+};
+
+/**************************************/
+/*   ModbusRTU device answer time     */
+/**************************************/
+struct tiny32_ModbusLatency
+{
+    uint8_t id;
+    uint16_t timeout_ms;    // timeout that is used for this device
+    uint16_t sample_count;  // answer since learn (again)
+    uint32_t average_us;    // smoothed answer time (EWMA 1/8)
+    uint32_t deviation_us;  // smoothed deviation (EWMA 1/4)
+    uint32_t max_us;        // slowest answer
+    uint32_t answer_count;  // all answer
+    uint32_t timeout_count; // no answer
+};
+
+/**************************************/
+/*     ModbusRTU device line setting  */
+/**************************************/
+struct tiny32_ModbusLine
+{
+    uint8_t id;
+    uint32_t baud;   // 0 = empty
+    uint32_t config; // SERIAL_8N1, SERIAL_8N2, ..
+};
+
+/**************************************/
+/*      ModbusRTU bus/device metrics  */
+/**************************************/
+struct tiny32_ModbusMetrics
+{
+    uint8_t id; // 0 = whole bus
+    uint32_t transaction;
+    uint32_t result[MODBUS_ERROR_COUNT]; // count of MODBUS_OK and each MODBUS_ERROR_xxx
+    uint32_t tx_byte;
+    uint32_t rx_byte;
+    uint64_t busy_us; // time in transaction
+    uint32_t max_us;  // slowest transaction
+    uint32_t histogram[MODBUS_HISTOGRAM_BIN];
+};
+
+struct tiny32_ModbusContention
+{
+    uint32_t lock_count;      // bus was owned (transaction or lock)
+    uint32_t contended_count; // task had to wait for other owner
+    uint64_t wait_us;         // total wait of contended lock
+    uint32_t wait_max_us;
+    uint32_t timeout_count;                        // lock was not get within timeout
+    uint32_t queue_count[MODBUS_PRIORITY_COUNT];   // job served by bus task (each lane)
+    uint64_t queue_wait_us[MODBUS_PRIORITY_COUNT]; // total time from submit to start of job
+    uint32_t queue_max_us[MODBUS_PRIORITY_COUNT];
+    uint32_t inversion_count; // urgent job was submitted while normal job was on the bus
+    uint64_t inversion_us;    // total wait of those urgent job
+    uint32_t inversion_max_us;
+};
+
+/**************************************/
+/*   ModbusRTU register block cache   */
+/**************************************/
+struct tiny32_ModbusSnapshot
+{
+    uint8_t id;
+    uint8_t function; // 0 = empty
+    uint16_t address;
+    uint16_t quantity;
+    uint32_t time_ms; // read time
+    uint8_t data[MODBUS_SNAPSHOT_REGISTER * 2];
+};
+
+/**************************************/
+/*   ModbusRTU job (asynchronous)     */
+/**************************************/
+/*  Job is own by caller and must stay alive until done() and callback return (queue keep pointer only)
+ *  - read  : function 0x03/0x04, value = quantity, data = quantity x 2 byte
+ *  - write : function 0x06, value = register value
+ *  - frame : frame != NULL, send frame[frame_len] and receive data_len byte to data
+ */
+struct tiny32_ModbusJob;
+typedef void (*modbus_callback_t)(tiny32_ModbusJob *job);
+
+struct tiny32_ModbusJob
+{
+    uint8_t id;
+    uint8_t function;
+    uint16_t address;
+    uint16_t value;
+    uint8_t *data;
+    uint16_t data_len;
+    const uint8_t *frame;
+    uint8_t frame_len;
+    bool quiet;
+    modbus_callback_t callback; // call from bus task when job finish
+    void *arg;                  // user argument for callback
+    TaskHandle_t notify;        // task to notify (xTaskNotifyGive) when job finish
+    uint32_t submit_us;         // micros() of submit (queue wait)
+    uint8_t priority;           // MODBUS_PRIORITY_NORMAL/ MODBUS_PRIORITY_URGENT
+    bool inversion;             // submitted while normal job was on the bus
+    volatile uint8_t status;
+    uint8_t error;     // MODBUS_OK or MODBUS_ERROR_xxx
+    uint8_t exception; // exception code of MODBUS_ERROR_EXCEPTION
+
+    tiny32_ModbusJob(void);
+    bool done(void);
+    bool success(void);
+    bool wait(uint32_t timeout_ms = portMAX_DELAY);
+};
+
+class tiny32_ModbusMaster
+{
+public:
+    tiny32_ModbusMaster(HardwareSerial &port, uint8_t bus_id = 1);
+    HardwareSerial &port(void);
+    uint8_t busId(void);
+    void begin(uint32_t baud, uint32_t config, int8_t rx, int8_t tx);
+    bool setDeviceLine(uint8_t id, uint32_t baud, uint32_t config);
+    bool useLine(uint8_t id, uint32_t baud, uint32_t config);
+    bool deviceLine(uint8_t id, uint32_t &baud, uint32_t &config);
+    bool sameLine(uint8_t id);
+    uint32_t lineSwitchCount(void);
+    void setTimeout(uint16_t timeout_ms);
+    uint16_t getTimeout(void);
+
+    /* request builder */
+    static uint16_t crc16_update(uint16_t crc, uint8_t a);
+    static uint16_t crc16(const uint8_t *data, uint16_t len);
+    static void appendCRC(uint8_t *frame, uint8_t len);
+    static uint8_t request(uint8_t *frame, uint8_t id, uint8_t function, uint16_t address, uint16_t value);
+    uint8_t cachedRequest(uint8_t *frame, uint8_t id, uint8_t function, uint16_t address, uint16_t value);
+    static uint16_t responseLength(const uint8_t *request, uint8_t request_len);
+    static uint32_t silence_us(uint32_t baud);
+    static int16_t findFrame(const uint8_t *data, uint16_t len, const uint8_t *request, uint16_t response_len, uint16_t *scan, uint16_t *frame_len);
+
+    /* transaction */
+    bool transaction(const uint8_t *request, uint8_t request_len, uint8_t *response, uint16_t response_len, bool quiet = false);
+    bool readRegisters(uint8_t id, uint8_t function, uint16_t address, uint16_t quantity, uint8_t *data, bool quiet = false);
+    bool writeRegister(uint8_t id, uint16_t address, uint16_t value);
+    int16_t searchAddress(uint8_t function, uint16_t address, uint16_t quantity, uint8_t first, uint8_t last, const char *name,
+                          uint32_t baud = 0, uint32_t config = SERIAL_8N1);
+    uint8_t discover(const tiny32_ModbusSignature *signature, uint8_t signature_count, uint8_t first, uint8_t last,
+                     tiny32_ModbusDevice *found, uint8_t found_max, bool probe_all = false, bool thorough = false);
+    uint16_t lastRxCount(void);
+    uint8_t lastError(void);
+    uint8_t lastException(void);
+    static const char *errorString(uint8_t error);
+    static const char *exceptionString(uint8_t exception);
+
+    /* adaptive timeout */
+    void setAdaptiveTimeout(bool enable, uint16_t floor_ms = MODBUS_TIMEOUT_FLOOR, uint16_t ceiling_ms = MODBUS_TIMEOUT_CEILING);
+    uint16_t deviceTimeout(uint8_t id);
+    tiny32_ModbusLatency *latency(uint8_t id);
+    void clearLatency(void);
+    void printLatency(void);
+
+    /* metrics */
+    void setMetrics(bool enable);
+    void resetMetrics(void);
+    const tiny32_ModbusMetrics *metrics(uint8_t id = 0);
+    float occupancy(void);
+    uint16_t metricsJSON(char *json, uint16_t size);
+    void printMetrics(void);
+    static uint8_t histogramBin(uint32_t time_us);
+
+    /* bus ownership */
+    bool lock(uint32_t timeout_ms = portMAX_DELAY);
+    void unlock(void);
+    const tiny32_ModbusContention *contention(void);
+
+    /* snapshot cache */
+    bool readSnapshot(uint8_t id, uint8_t function, uint16_t address, uint16_t quantity, uint8_t *data, bool quiet = false, uint32_t *time_ms = NULL);
+    void setSnapshotTTL(uint16_t ttl_ms);
+    uint16_t getSnapshotTTL(void);
+    void clearSnapshot(uint8_t id);
+
+    /* asynchronous (bus task) */
+    bool beginTask(UBaseType_t priority = 2, BaseType_t core = 0, uint8_t queue_size = MODBUS_QUEUE_SIZE);
+    bool taskRunning(void);
+    bool submit(tiny32_ModbusJob *job);
+    bool run(tiny32_ModbusJob *job);
+    bool readAsync(tiny32_ModbusJob *job, uint8_t id, uint8_t function, uint16_t address, uint16_t quantity, uint8_t *data, modbus_callback_t callback = NULL, void *arg = NULL,
+                   uint8_t priority = MODBUS_PRIORITY_NORMAL);
+    bool writeAsync(tiny32_ModbusJob *job, uint8_t id, uint16_t address, uint16_t value, modbus_callback_t callback = NULL, void *arg = NULL);
+
+    /* register decoder (data point to first byte of register), see tiny32_ModbusDecode.h for other type */
+    static uint16_t toUint16(const uint8_t *data);
+    static int16_t toInt16(const uint8_t *data);
+    static uint32_t toUint32(const uint8_t *data);
+    static uint32_t toUint32_CDAB(const uint8_t *data);
+    static float toFloat(const uint8_t *data);
+    static float toFloat_CDAB(const uint8_t *data);
+
+private:
+    HardwareSerial &_port;
+    uint8_t _bus_id;
+    uint32_t _default_baud; // line setting of begin, 0 = not managed
+    uint32_t _default_config;
+    uint32_t _probe_baud;   // line of searchAddress for id without own setting (0 = default)
+    uint32_t _probe_config;
+    uint32_t _baud; // line setting of the port now
+    uint32_t _config;
+    int8_t _rx;
+    int8_t _tx;
+    tiny32_ModbusLine _line[MODBUS_LINE_MAX];
+    uint32_t _line_switch_count;
+    uint64_t _line_switch_us;
+    uint32_t _line_switch_max_us;
+    uint16_t _timeout;
+    uint16_t _probe_timeout;     // short timeout of discover (0 = not probing)
+    volatile uint16_t _rx_count; // byte received by the last transaction
+    uint8_t _error;              // result of the last transaction
+    uint8_t _exception;          // exception code of the last transaction
+    uint8_t _request_cache[MODBUS_REQUEST_CACHE][8];
+    tiny32_ModbusSnapshot _snapshot[MODBUS_SNAPSHOT_MAX];
+    uint16_t _snapshot_ttl;
+    portMUX_TYPE _snapshot_mux = portMUX_INITIALIZER_UNLOCKED;
+    tiny32_ModbusLatency _latency[MODBUS_LATENCY_MAX];
+    bool _adaptive;
+    uint16_t _timeout_floor;
+    uint16_t _timeout_ceiling;
+    uint32_t _answer_us; // first byte time of the last transaction
+    SemaphoreHandle_t _mutex;
+    tiny32_ModbusContention _contention;
+    tiny32_ModbusMetrics _metrics;
+    tiny32_ModbusMetrics _device_metrics[MODBUS_METRICS_DEVICE_MAX];
+    uint32_t _metrics_start_ms;
+    bool _metrics_enable;
+    TaskHandle_t _task;
+    QueueHandle_t _queue;        // normal lane
+    QueueHandle_t _urgent_queue; // urgent lane
+    volatile uint8_t _running_priority; // priority of job on the bus, MODBUS_PRIORITY_COUNT = idle
+    void applyLine(uint8_t id);
+    void record(uint8_t id, uint8_t request_len, uint8_t result, uint32_t time_us);
+    void learn(uint8_t id, uint8_t result);
+    tiny32_ModbusSnapshot *snapshotSlot(uint8_t id, uint8_t function, uint16_t address, uint16_t quantity, bool oldest);
+    static int16_t header(const uint8_t *data, uint16_t len, const uint8_t *request);
+    static int16_t foreignFrame(const uint8_t *data, uint16_t len, const uint8_t *request);
+    uint8_t receive(const uint8_t *request, uint8_t request_len, uint8_t *response, uint16_t response_len);
+    bool exchange(const uint8_t *request, uint8_t request_len, uint8_t *response, uint16_t response_len, bool quiet);
+    bool execute(tiny32_ModbusJob *job);
+    static void busTask(void *arg);
+    void debugFrame(const char *title, const uint8_t *frame, uint16_t len);
+};
+
+/* RS485 bus and line setting of one device driver, at(id) keep the line of
+   id on the bus before it is used (other driver on the bus don't change it) */
+struct tiny32_ModbusDriver
+{
+    tiny32_ModbusMaster *bus;
+    uint32_t baud;
+    uint32_t config;
+
+    tiny32_ModbusMaster *at(uint8_t id)
+    {
+        bus->useLine(id, baud, config);
+        return bus;
+    }
+};
+
+extern tiny32_ModbusMaster modbus_rs485;
+extern tiny32_ModbusMaster modbus_rs485_2;
+#endif
@@ -0,0 +1,337 @@
+/***********************************************************************
+ * File         :     tiny32_ModbusPlanner.cpp
+ * Description  :     ModbusRTU read planner, merge the register of requested
+ *                    point into as few block read as possible (per id and
+ *                    function code) and decode each block back to the point
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17 Oct 2026
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     089-140-7205
+ ***********************************************************************/
+
+#include "tiny32_ModbusPlanner.h"
+#include "Arduino.h"
+
+tiny32_ModbusPlanner::tiny32_ModbusPlanner(uint16_t max_gap, uint16_t max_quantity)
+{
+  _max_gap = max_gap;
+  setMaxQuantity(max_quantity);
+  clear();
+}
+
+/***********************************************************************
+ * FUNCTION:    setMaxGap
+ * DESCRIPTION: Maximum unused register that can be read between 2 point
+ *              (0 = merge contiguous point only, for device that answer
+ *              exception to unmapped register)
+ * PARAMETERS:  max_gap
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusPlanner::setMaxGap(uint16_t max_gap)
+{
+  _max_gap = max_gap;
+  _planned = false;
+}
+
+/***********************************************************************
+ * FUNCTION:    setMaxQuantity
+ * DESCRIPTION: Maximum register of one block read [1-125]
+ * PARAMETERS:  max_quantity
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusPlanner::setMaxQuantity(uint16_t max_quantity)
+{
+  if ((max_quantity == 0) || (max_quantity > MODBUS_REGISTER_MAX))
+    max_quantity = MODBUS_REGISTER_MAX;
+
+  _max_quantity = max_quantity;
+  _planned = false;
+}
+
+/***********************************************************************
+ * FUNCTION:    clear
+ * DESCRIPTION: Remove all point and block
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusPlanner::clear(void)
+{
+  _item_count = 0;
+  _block_count = 0;
+  _planned = false;
+}
+
+/***********************************************************************
+ * FUNCTION:    add
+ * DESCRIPTION: Add point to the plan
+ * PARAMETERS:  id, function(0x03/0x04), address, format(MODBUS_xxx),
+ *              value(pointer of result), scale
+ * RETURNED:    index of point, -1 = error
+ ***********************************************************************/
+int16_t tiny32_ModbusPlanner::add(uint8_t id, uint8_t function, uint16_t address, uint8_t format, float *value, float scale)
+{
+  if (_item_count >= MODBUS_PLAN_ITEM_MAX)
+  {
+    Serial.printf("Error: plan point is full[%d]\r\n", MODBUS_PLAN_ITEM_MAX);
+    return -1;
+  }
+
+  if ((format > MODBUS_FLOAT_CDAB) || (value == NULL))
+  {
+    Serial.printf("Error: plan point parameter is out of the range\r\n");
+    return -1;
+  }
+
+  tiny32_ModbusItem *_p = &_item[_item_count];
+  _p->id = id;
+  _p->function = function;
+  _p->address = address;
+  _p->format = format;
+  _p->scale = scale;
+  _p->value = value;
+  _p->valid = false;
+  _p->block = 0;
+  _planned = false;
+
+  return _item_count++;
+}
+
+/***********************************************************************
+ * FUNCTION:    plan
+ * DESCRIPTION: Sort point by id, function and address then merge point
+ *              into block while the gap <= max gap and the block <= max
+ *              quantity
+ * PARAMETERS:  nothing
+ * RETURNED:    number of block, 0 = error
+ ***********************************************************************/
+uint8_t tiny32_ModbusPlanner::plan(void)
+{
+  uint8_t _order[MODBUS_PLAN_ITEM_MAX];
+
+  /*** sort (insertion sort, small list) ***/
+  for (uint8_t _i = 0; _i < _item_count; _i++)
+  {
+    uint8_t _j = _i;
+    uint32_t _key = ((uint32_t)_item[_i].id << 24) | ((uint32_t)_item[_i].function << 16) | _item[_i].address;
+
+    while (_j > 0)
+    {
+      tiny32_ModbusItem *_q = &_item[_order[_j - 1]];
+      if ((((uint32_t)_q->id << 24) | ((uint32_t)_q->function << 16) | _q->address) <= _key)
+        break;
+      _order[_j] = _order[_j - 1];
+      _j--;
+    }
+    _order[_j] = _i;
+  }
+
+  /*** merge ***/
+  _block_count = 0;
+  tiny32_ModbusBlock *_b = NULL;
+  for (uint8_t _i = 0; _i < _item_count; _i++)
+  {
+    tiny32_ModbusItem *_p = &_item[_order[_i]];
+    uint32_t _end = (uint32_t)_p->address + registers(_p->format); // register after point
+
+    if ((_b != NULL) && (_b->id == _p->id) && (_b->function == _p->function) &&
+        ((uint32_t)_p->address <= (uint32_t)_b->address + _b->quantity + _max_gap) &&
+        (_end - _b->address <= _max_quantity))
+    {
+      if (_end > (uint32_t)_b->address + _b->quantity)
+        _b->quantity = _end - _b->address;
+    }
+    else
+    {
+      if (_block_count >= MODBUS_PLAN_BLOCK_MAX)
+      {
+        Serial.printf("Error: plan block is full[%d]\r\n", MODBUS_PLAN_BLOCK_MAX);
+        _block_count = 0;
+        return 0;
+      }
+      _b = &_block[_block_count++];
+      _b->id = _p->id;
+      _b->function = _p->function;
+      _b->address = _p->address;
+      _b->quantity = registers(_p->format);
+      _b->valid = false;
+    }
+    _p->block = _block_count - 1;
+  }
+
+  _planned = true;
+  return _block_count;
+}
+
+/***********************************************************************
+ * FUNCTION:    blockCount
+ * DESCRIPTION: Number of block of the last plan
+ * PARAMETERS:  nothing
+ * RETURNED:    number of block
+ ***********************************************************************/
+uint8_t tiny32_ModbusPlanner::blockCount(void)
+{
+  return _block_count;
+}
+
+/***********************************************************************
+ * FUNCTION:    block
+ * DESCRIPTION: Block of index
+ * PARAMETERS:  index
+ * RETURNED:    tiny32_ModbusBlock, NULL = no block
+ ***********************************************************************/
+tiny32_ModbusBlock *tiny32_ModbusPlanner::block(uint8_t index)
+{
+  if (index >= _block_count)
+    return NULL;
+
+  return &_block[index];
+}
+
+/***********************************************************************
+ * FUNCTION:    item
+ * DESCRIPTION: Point of index
+ * PARAMETERS:  index
+ * RETURNED:    tiny32_ModbusItem, NULL = no point
+ ***********************************************************************/
+tiny32_ModbusItem *tiny32_ModbusPlanner::item(uint8_t index)
+{
+  if (index >= _item_count)
+    return NULL;
+
+  return &_item[index];
+}
+
+/***********************************************************************
+ * FUNCTION:    itemCount
+ * DESCRIPTION: Number of point
+ * PARAMETERS:  nothing
+ * RETURNED:    number of point
+ ***********************************************************************/
+uint8_t tiny32_ModbusPlanner::itemCount(void)
+{
+  return _item_count;
+}
+
+/***********************************************************************
+ * FUNCTION:    spread
+ * DESCRIPTION: Decode data of block to all point in the block and publish
+ *              each point to modbus_tag
+ * PARAMETERS:  index of block, data(quantity x 2 byte, NULL = read fail),
+ *              bus (busId of tag, 0 = not publish)
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusPlanner::spread(uint8_t index, const uint8_t *data, uint8_t bus)
+{
+  if (index >= _block_count)
+    return;
+
+  tiny32_ModbusBlock *_b = &_block[index];
+  _b->valid = (data != NULL);
+
+  for (uint8_t _i = 0; _i < _item_count; _i++)
+  {
+    tiny32_ModbusItem *_p = &_item[_i];
+    if (_p->block != index)
+      continue;
+
+    _p->valid = _b->valid;
+    if (_p->valid)
+      *_p->value = decode(&data[(_p->address - _b->address) * 2], _p->format, _p->scale);
+    if (bus != 0)
+      modbus_tag.publish(bus, _p->id, _p->function, _p->address, *_p->value, _p->valid);
+  }
+}
+
+/***********************************************************************
+ * FUNCTION:    read
+ * DESCRIPTION: Read every block (plan first if point was changed) and
+ *              decode to the point
+ * PARAMETERS:  bus
+ * RETURNED:    true = all block success, false = some point are not valid
+ ***********************************************************************/
+bool tiny32_ModbusPlanner::read(tiny32_ModbusMaster &bus)
+{
+  uint8_t _data[MODBUS_REGISTER_MAX * 2];
+  bool _success = true;
+
+  if (!_planned && (plan() == 0))
+    return false;
+
+  for (uint8_t _i = 0; _i < _block_count; _i++)
+  {
+    tiny32_ModbusBlock *_b = &_block[_i];
+    if (bus.readRegisters(_b->id, _b->function, _b->address, _b->quantity, _data))
+    {
+      spread(_i, _data, bus.busId());
+    }
+    else
+    {
+      spread(_i, NULL, bus.busId());
+      _success = false;
+    }
+  }
+
+  return _success;
+}
+
+/***********************************************************************
+ * FUNCTION:    printPlan
+ * DESCRIPTION: Print out block of the plan
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusPlanner::printPlan(void)
+{
+  if (!_planned)
+    plan();
+
+  Serial.printf("\r\nInfo: %d point => %d block (max gap = %d, max quantity = %d)\r\n", _item_count, _block_count, _max_gap, _max_quantity);
+  for (uint8_t _i = 0; _i < _block_count; _i++)
+  {
+    uint8_t _n = 0;
+    for (uint8_t _j = 0; _j < _item_count; _j++)
+      if (_item[_j].block == _i)
+        _n++;
+
+    Serial.printf("  block %d: id %d fc 0x%02X address 0x%04X quantity %d (%d point)\r\n", _i, _block[_i].id, _block[_i].function, _block[_i].address, _block[_i].quantity, _n);
+  }
+}
+
+/***********************************************************************
+ * FUNCTION:    registers
+ * DESCRIPTION: Number of register of data format
+ * PARAMETERS:  format
+ * RETURNED:    1 or 2
+ ***********************************************************************/
+uint8_t tiny32_ModbusPlanner::registers(uint8_t format)
+{
+  return (format <= MODBUS_INT16) ? 1 : 2;
+}
+
+/***********************************************************************
+ * FUNCTION:    decode
+ * DESCRIPTION: Decode register data to float
+ * PARAMETERS:  data, format, scale
+ * RETURNED:    value x scale
+ ***********************************************************************/
+float tiny32_ModbusPlanner::decode(const uint8_t *data, uint8_t format, float scale)
+{
+  switch (format)
+  {
+  case MODBUS_UINT16:
+    return tiny32_ModbusUint16<>::raw(data) * scale;
+  case MODBUS_INT16:
+    return tiny32_ModbusInt16<>::raw(data) * scale;
+  case MODBUS_UINT32:
+    return tiny32_ModbusUint32<MODBUS_ORDER_ABCD>::raw(data) * scale;
+  case MODBUS_UINT32_CDAB:
+    return tiny32_ModbusUint32<MODBUS_ORDER_CDAB>::raw(data) * scale;
+  case MODBUS_FLOAT:
+    return tiny32_ModbusFloat<MODBUS_ORDER_ABCD>::raw(data) * scale;
+  case MODBUS_FLOAT_CDAB:
+    return tiny32_ModbusFloat<MODBUS_ORDER_CDAB>::raw(data) * scale;
+  default:
+    return 0;
+  }
+}
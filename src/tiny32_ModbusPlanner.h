@@ -0,0 +1,90 @@
+/***********************************************************************
+ * File         :     tiny32_ModbusPlanner.h
+ * Description  :     ModbusRTU read planner, merge the register of requested
+ *                    point into as few block read as possible (per id and
+ *                    function code) and decode each block back to the point
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17 Oct 2026
+ * Revision     :     1.1
+ * Rev1.0       :     Original
+ * Rev1.1       :     Publish decoded point to modbus_tag
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     089-140-7205
+ ***********************************************************************/
+
+#ifndef TINY32_MODBUSPLANNER_H
+#define TINY32_MODBUSPLANNER_H
+#include "Arduino.h"
+#include "tiny32_ModbusMaster.h"
+#include "tiny32_ModbusTag.h"
+
+/**************************************/
+/*     ModbusRTU planner define       */
+/**************************************/
+#define MODBUS_PLAN_ITEM_MAX 64  // maximum number of point in one plan
+#define MODBUS_PLAN_BLOCK_MAX 32 // maximum number of block read in one plan
+#define MODBUS_PLAN_GAP 8        // default maximum unused register between 2 point in one block
+
+/**************************************/
+/*        register data format        */
+/**************************************/
+#define MODBUS_UINT16 0      // 1 register
+#define MODBUS_INT16 1       // 1 register
+#define MODBUS_UINT32 2      // 2 register, high word first [ABCD]
+#define MODBUS_UINT32_CDAB 3 // 2 register, low word first [CDAB] (PZEM)
+#define MODBUS_FLOAT 4       // 2 register, IEEE754 [ABCD] (SDM, Schneider, ENenergic)
+#define MODBUS_FLOAT_CDAB 5  // 2 register, IEEE754 [CDAB] (tiny32 ModbusRTU)
+
+struct tiny32_ModbusItem
+{
+    uint8_t id;
+    uint8_t function;
+    uint16_t address;
+    uint8_t format;
+    float scale;
+    float *value; // decoded value (value x scale)
+    bool valid;   // value was updated by the last read
+    uint8_t block;
+};
+
+struct tiny32_ModbusBlock
+{
+    uint8_t id;
+    uint8_t function;
+    uint16_t address;
+    uint16_t quantity;
+    bool valid; // the last read was success
+};
+
+class tiny32_ModbusPlanner
+{
+public:
+    tiny32_ModbusPlanner(uint16_t max_gap = MODBUS_PLAN_GAP, uint16_t max_quantity = MODBUS_REGISTER_MAX);
+    void setMaxGap(uint16_t max_gap);
+    void setMaxQuantity(uint16_t max_quantity);
+    void clear(void);
+    int16_t add(uint8_t id, uint8_t function, uint16_t address, uint8_t format, float *value, float scale = 1);
+
+    uint8_t plan(void);
+    uint8_t blockCount(void);
+    tiny32_ModbusBlock *block(uint8_t index);
+    tiny32_ModbusItem *item(uint8_t index);
+    uint8_t itemCount(void);
+    void spread(uint8_t index, const uint8_t *data, uint8_t bus = 0);
+    bool read(tiny32_ModbusMaster &bus);
+    void printPlan(void);
+
+    static uint8_t registers(uint8_t format);
+    static float decode(const uint8_t *data, uint8_t format, float scale = 1);
+
+private:
+    tiny32_ModbusItem _item[MODBUS_PLAN_ITEM_MAX];
+    tiny32_ModbusBlock _block[MODBUS_PLAN_BLOCK_MAX];
+    uint8_t _item_count;
+    uint8_t _block_count;
+    uint16_t _max_gap;
+    uint16_t _max_quantity;
+    bool _planned;
+};
+#endif
@@ -0,0 +1,394 @@
+/***********************************************************************
+ * File         :     tiny32_ModbusScheduler.cpp
+ * Description  :     ModbusRTU polling scheduler, each point (id + register
+ *                    block) has own period and the bus always serve the
+ *                    ready point with earliest deadline (EDF)
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17 Oct 2026
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     089-140-7205
+ ***********************************************************************/
+
+#include "tiny32_ModbusScheduler.h"
+#include "tiny32_ModbusPlanner.h"
+#include "tiny32_ModbusTag.h"
+#include "Arduino.h"
+
+tiny32_ModbusScheduler::tiny32_ModbusScheduler(tiny32_ModbusMaster &bus) : _bus(bus)
+{
+  _count = 0;
+  _task = NULL;
+  _start_ms = 0;
+  _busy_ms = 0;
+  _line_slack_ms = MODBUS_LINE_SLACK;
+}
+
+/***********************************************************************
+ * FUNCTION:    addPoint
+ * DESCRIPTION: Add register block to poll every period_ms, the first poll
+ *              is ready immediately
+ * PARAMETERS:  id, function(0x03/0x04), address, quantity, period_ms,
+ *              data(quantity x 2 byte), callback, arg
+ * RETURNED:    index of point, -1 = error
+ ***********************************************************************/
+int8_t tiny32_ModbusScheduler::addPoint(uint8_t id, uint8_t function, uint16_t address, uint16_t quantity, uint32_t period_ms, uint8_t *data, modbus_point_callback_t callback, void *arg)
+{
+  if (_count >= MODBUS_POINT_MAX)
+  {
+    Serial.printf("Error: point is full[%d]\r\n", MODBUS_POINT_MAX);
+    return -1;
+  }
+
+  if ((quantity == 0) || (quantity > MODBUS_REGISTER_MAX) || (period_ms == 0) || (data == NULL))
+  {
+    Serial.printf("Error: point parameter is out of the range\r\n");
+    return -1;
+  }
+
+  tiny32_ModbusPoint *_p = &_point[_count];
+  memset(_p, 0, sizeof(tiny32_ModbusPoint));
+  _p->id = id;
+  _p->function = function;
+  _p->address = address;
+  _p->quantity = quantity;
+  _p->data = data;
+  _p->period_ms = period_ms;
+  _p->callback = callback;
+  _p->arg = arg;
+  _p->format = MODBUS_RAW;
+  _p->scale = 1;
+  _p->release_ms = millis();
+  _p->deadline_ms = _p->release_ms + period_ms;
+
+  if (_count == 0)
+    _start_ms = _p->release_ms;
+
+  return _count++;
+}
+
+/***********************************************************************
+ * FUNCTION:    point
+ * DESCRIPTION: Point of index
+ * PARAMETERS:  index
+ * RETURNED:    tiny32_ModbusPoint, NULL = no point
+ ***********************************************************************/
+tiny32_ModbusPoint *tiny32_ModbusScheduler::point(uint8_t index)
+{
+  if (index >= _count)
+    return NULL;
+
+  return &_point[index];
+}
+
+/***********************************************************************
+ * FUNCTION:    count
+ * DESCRIPTION: Number of point
+ * PARAMETERS:  nothing
+ * RETURNED:    number of point
+ ***********************************************************************/
+uint8_t tiny32_ModbusScheduler::count(void)
+{
+  return _count;
+}
+
+/***********************************************************************
+ * FUNCTION:    setFormat
+ * DESCRIPTION: Decode block of point as value of format that follow each
+ *              other and publish each value to modbus_tag after every poll
+ *              (point is MODBUS_RAW = data only after addPoint)
+ * PARAMETERS:  index, format(MODBUS_RAW, MODBUS_UINT16..), scale
+ * RETURNED:    true/ false
+ ***********************************************************************/
+bool tiny32_ModbusScheduler::setFormat(uint8_t index, uint8_t format, float scale)
+{
+  if ((index >= _count) || ((format != MODBUS_RAW) && (format > MODBUS_FLOAT_CDAB)))
+  {
+    Serial.printf("Error: point format is out of the range\r\n");
+    return false;
+  }
+
+  _point[index].format = format;
+  _point[index].scale = scale;
+  return true;
+}
+
+/***********************************************************************
+ * FUNCTION:    next
+ * DESCRIPTION: Ready point (release time passed) with earliest deadline,
+ *              a ready point on the line setting of the port now is taken
+ *              first when its deadline is within line slack, so device
+ *              with the same baud/ parity are polled back to back
+ * PARAMETERS:  now_ms
+ * RETURNED:    index of point, -1 = no point is ready
+ ***********************************************************************/
+int8_t tiny32_ModbusScheduler::next(uint32_t now_ms)
+{
+  int8_t _next = -1;
+  int8_t _same = -1; // earliest point that need no line switch
+  int32_t _earliest = 0;
+  int32_t _earliest_same = 0;
+
+  for (uint8_t _i = 0; _i < _count; _i++)
+  {
+    if ((int32_t)(now_ms - _point[_i].release_ms) < 0)
+      continue;
+
+    int32_t _deadline = (int32_t)(_point[_i].deadline_ms - now_ms); // millis() roll over safe
+    if ((_next < 0) || (_deadline < _earliest))
+    {
+      _next = _i;
+      _earliest = _deadline;
+    }
+    if ((_line_slack_ms > 0) && ((_same < 0) || (_deadline < _earliest_same)) && _bus.sameLine(_point[_i].id))
+    {
+      _same = _i;
+      _earliest_same = _deadline;
+    }
+  }
+
+  if ((_same >= 0) && ((uint32_t)(_earliest_same - _earliest) <= _line_slack_ms))
+    return _same;
+
+  return _next;
+}
+
+/***********************************************************************
+ * FUNCTION:    setLineSlack
+ * DESCRIPTION: Maximum time that a point on the line setting of the port
+ *              now can go before a point with earlier deadline (0 = pure
+ *              earliest deadline first)
+ * PARAMETERS:  slack_ms
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusScheduler::setLineSlack(uint32_t slack_ms)
+{
+  _line_slack_ms = slack_ms;
+}
+
+/***********************************************************************
+ * FUNCTION:    idle_ms
+ * DESCRIPTION: Time until the next point is ready
+ * PARAMETERS:  now_ms
+ * RETURNED:    mS, 0 = some point is ready
+ ***********************************************************************/
+uint32_t tiny32_ModbusScheduler::idle_ms(uint32_t now_ms)
+{
+  int32_t _idle = INT32_MAX;
+
+  for (uint8_t _i = 0; _i < _count; _i++)
+  {
+    int32_t _wait = (int32_t)(_point[_i].release_ms - now_ms);
+    if (_wait < _idle)
+      _idle = _wait;
+  }
+
+  return (_idle < 0) ? 0 : _idle;
+}
+
+/***********************************************************************
+ * FUNCTION:    poll
+ * DESCRIPTION: Read one ready point (earliest deadline first) and move it
+ *              to the next period. A point that is late by more than one
+ *              period skip the lost periods (count as miss) instead of
+ *              burst reading to catch up, so slow point are never starved
+ * PARAMETERS:  nothing
+ * RETURNED:    true = one point was polled, false = no point is ready
+ ***********************************************************************/
+bool tiny32_ModbusScheduler::poll(void)
+{
+  uint32_t _start = millis();
+  int8_t _index = next(_start);
+
+  if (_index < 0)
+    return false;
+
+  tiny32_ModbusPoint *_p = &_point[_index];
+  tiny32_ModbusJob _job;
+  _job.id = _p->id;
+  _job.function = _p->function;
+  _job.address = _p->address;
+  _job.value = _p->quantity;
+  _job.data = _p->data;
+  _job.data_len = _p->quantity * 2;
+  _job.quiet = true;
+  bool _success = _bus.run(&_job);
+  uint32_t _finish = millis();
+
+  _busy_ms += _finish - _start;
+  _p->poll_count++;
+  if (_success)
+  {
+    if (_p->success_count == 0)
+      _p->first_ms = _finish;
+    _p->last_ms = _finish;
+    _p->success_count++;
+  }
+  else
+  {
+    _p->error_count++;
+    if (_job.error == MODBUS_ERROR_EXCEPTION)
+    {
+      _p->exception_count++;
+      _p->last_exception = _job.exception;
+    }
+  }
+  _p->last_error = _job.error;
+
+  /*** deadline check ***/
+  int32_t _late = (int32_t)(_finish - _p->deadline_ms);
+  if (_late > 0)
+  {
+    _p->miss_count++;
+    if ((uint32_t)_late > _p->max_late_ms)
+      _p->max_late_ms = _late;
+  }
+
+  /*** next period ***/
+  _p->release_ms += _p->period_ms;
+  while ((int32_t)(_finish - (_p->release_ms + _p->period_ms)) >= 0)
+  {
+    _p->release_ms += _p->period_ms; // whole period was lost
+    _p->miss_count++;
+  }
+  _p->deadline_ms = _p->release_ms + _p->period_ms;
+
+  /*** publish ***/
+  if (_p->format != MODBUS_RAW)
+  {
+    uint8_t _step = tiny32_ModbusPlanner::registers(_p->format);
+    for (uint16_t _i = 0; (_i + _step) <= _p->quantity; _i += _step)
+    {
+      float _value = _success ? tiny32_ModbusPlanner::decode(&_p->data[_i * 2], _p->format, _p->scale) : 0;
+      modbus_tag.publish(_bus.busId(), _p->id, _p->function, _p->address + _i, _value, _success);
+    }
+  }
+
+  if (_p->callback != NULL)
+    _p->callback(_p, _success);
+
+  return true;
+}
+
+/***********************************************************************
+ * FUNCTION:    run
+ * DESCRIPTION: Poll forever, sleep only when no point is ready
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusScheduler::run(void)
+{
+  for (;;)
+  {
+    if (!poll())
+    {
+      uint32_t _idle = idle_ms(millis());
+      vTaskDelay((_idle > 0) ? pdMS_TO_TICKS(_idle) : 1);
+    }
+  }
+}
+
+/***********************************************************************
+ * FUNCTION:    beginTask
+ * DESCRIPTION: Start scheduler task (run)
+ * PARAMETERS:  priority, core
+ * RETURNED:    true/ false
+ ***********************************************************************/
+bool tiny32_ModbusScheduler::beginTask(UBaseType_t priority, BaseType_t core)
+{
+  if (_task != NULL)
+    return true;
+
+  if (xTaskCreatePinnedToCore(schedulerTask, "modbus_poll", 4096, this, priority, &_task, core) != pdPASS)
+  {
+    Serial.printf("Error: can't create ModbusRTU scheduler task\r\n");
+    _task = NULL;
+    return false;
+  }
+
+  return true;
+}
+
+/***********************************************************************
+ * FUNCTION:    schedulerTask
+ * DESCRIPTION: FreeRTOS task of scheduler
+ * PARAMETERS:  tiny32_ModbusScheduler
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusScheduler::schedulerTask(void *arg)
+{
+  ((tiny32_ModbusScheduler *)arg)->run();
+}
+
+/***********************************************************************
+ * FUNCTION:    resetStatus
+ * DESCRIPTION: Clear counter of all point and bus utilization
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusScheduler::resetStatus(void)
+{
+  for (uint8_t _i = 0; _i < _count; _i++)
+  {
+    _point[_i].poll_count = 0;
+    _point[_i].success_count = 0;
+    _point[_i].error_count = 0;
+    _point[_i].exception_count = 0;
+    _point[_i].miss_count = 0;
+    _point[_i].max_late_ms = 0;
+  }
+  _start_ms = millis();
+  _busy_ms = 0;
+}
+
+/***********************************************************************
+ * FUNCTION:    utilization
+ * DESCRIPTION: Part of time that bus was in transaction since resetStatus
+ * PARAMETERS:  nothing
+ * RETURNED:    0.0 - 1.0
+ ***********************************************************************/
+float tiny32_ModbusScheduler::utilization(void)
+{
+  uint32_t _elapsed = millis() - _start_ms;
+
+  if (_elapsed == 0)
+    return 0;
+
+  return (float)_busy_ms / _elapsed;
+}
+
+/***********************************************************************
+ * FUNCTION:    printStatus
+ * DESCRIPTION: Print out requested vs achieved period of all point
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusScheduler::printStatus(void)
+{
+  Serial.printf("\r\n id  fc  addr  qty  period[mS]  achieved[mS]   poll  error  exception  miss  late[mS]  last error\r\n");
+  for (uint8_t _i = 0; _i < _count; _i++)
+  {
+    tiny32_ModbusPoint *_p = &_point[_i];
+    Serial.printf("%3d  %02X  %04X  %3d  %10d  %12.1f  %5d  %5d  %9d  %4d  %8d  %s", _p->id, _p->function, _p->address, _p->quantity,
+                  _p->period_ms, _p->achievedPeriod(), _p->poll_count, _p->error_count, _p->exception_count, _p->miss_count, _p->max_late_ms,
+                  tiny32_ModbusMaster::errorString(_p->last_error));
+    if (_p->last_error == MODBUS_ERROR_EXCEPTION)
+      Serial.printf(" 0x%02X (%s)", _p->last_exception, tiny32_ModbusMaster::exceptionString(_p->last_exception));
+    Serial.printf("\r\n");
+  }
+  Serial.printf("bus utilization: %.1f%%, line switch: %u\r\n", utilization() * 100, (unsigned)_bus.lineSwitchCount());
+}
+
+/***********************************************************************
+ * FUNCTION:    achievedPeriod
+ * DESCRIPTION: Average time between success poll
+ * PARAMETERS:  nothing
+ * RETURNED:    mS, 0 = less than 2 success poll
+ ***********************************************************************/
+float tiny32_ModbusPoint::achievedPeriod(void)
+{
+  if (success_count < 2)
+    return 0;
+
+  return (float)(last_ms - first_ms) / (success_count - 1);
+}
@@ -0,0 +1,95 @@
+/***********************************************************************
+ * File         :     tiny32_ModbusScheduler.h
+ * Description  :     ModbusRTU polling scheduler, each point (id + register
+ *                    block) has own period and the bus always serve the
+ *                    ready point with earliest deadline (EDF)
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17 Oct 2026
+ * Revision     :     1.2
+ * Rev1.0       :     Original
+ * Rev1.1       :     Keep error/exception reason of each point
+ * Rev1.2       :     Poll device with the same line setting back to back (line slack)
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     089-140-7205
+ ***********************************************************************/
+
+#ifndef TINY32_MODBUSSCHEDULER_H
+#define TINY32_MODBUSSCHEDULER_H
+#include "Arduino.h"
+#include "tiny32_ModbusMaster.h"
+
+/**************************************/
+/*     ModbusRTU scheduler define     */
+/**************************************/
+#define MODBUS_POINT_MAX 32  // maximum number of point for one scheduler (one bus)
+#define MODBUS_LINE_SLACK 50 // mS, default deadline slack to avoid line switch
+#define MODBUS_RAW 0xFF      // point format, block is kept as raw data only (not publish to modbus_tag)
+
+/**************************************/
+/*        ModbusRTU poll point        */
+/**************************************/
+struct tiny32_ModbusPoint;
+typedef void (*modbus_point_callback_t)(tiny32_ModbusPoint *point, bool success);
+
+struct tiny32_ModbusPoint
+{
+    uint8_t id;
+    uint8_t function;
+    uint16_t address;
+    uint16_t quantity;
+    uint8_t *data;                    // quantity x 2 byte, update after each success poll
+    uint32_t period_ms;               // target sample period
+    modbus_point_callback_t callback; // call from scheduler after each poll
+    void *arg;                        // user argument for callback
+    uint8_t format;                   // MODBUS_RAW or MODBUS_UINT16.. of tiny32_ModbusPlanner.h (setFormat)
+    float scale;                      // value x scale of format
+
+    /* status (update by scheduler) */
+    uint32_t release_ms;  // point is ready from this time
+    uint32_t deadline_ms; // release_ms + period_ms
+    uint32_t poll_count;
+    uint32_t error_count;
+    uint32_t miss_count;  // finish after deadline or a whole period was skipped
+    uint32_t max_late_ms; // worst finish time after deadline
+    uint32_t first_ms;    // first success poll
+    uint32_t last_ms;     // last success poll
+    uint32_t success_count;
+    uint32_t exception_count;
+    uint8_t last_error;     // MODBUS_OK or MODBUS_ERROR_xxx of the last poll
+    uint8_t last_exception; // exception code of the last exception response
+
+    float achievedPeriod(void);
+};
+
+class tiny32_ModbusScheduler
+{
+public:
+    tiny32_ModbusScheduler(tiny32_ModbusMaster &bus);
+    int8_t addPoint(uint8_t id, uint8_t function, uint16_t address, uint16_t quantity, uint32_t period_ms, uint8_t *data, modbus_point_callback_t callback = NULL, void *arg = NULL);
+    tiny32_ModbusPoint *point(uint8_t index);
+    uint8_t count(void);
+    bool setFormat(uint8_t index, uint8_t format, float scale = 1);
+
+    int8_t next(uint32_t now_ms);
+    void setLineSlack(uint32_t slack_ms);
+    uint32_t idle_ms(uint32_t now_ms);
+    bool poll(void);
+    void run(void);
+    bool beginTask(UBaseType_t priority = 1, BaseType_t core = 0);
+
+    void resetStatus(void);
+    float utilization(void);
+    void printStatus(void);
+
+private:
+    tiny32_ModbusMaster &_bus;
+    tiny32_ModbusPoint _point[MODBUS_POINT_MAX];
+    uint8_t _count;
+    TaskHandle_t _task;
+    uint32_t _start_ms; // begin of status period
+    uint32_t _busy_ms;  // time in transaction since _start_ms
+    uint32_t _line_slack_ms;
+    static void schedulerTask(void *arg);
+};
+#endif
@@ -0,0 +1,304 @@
+/***********************************************************************
+ * File         :     tiny32_ModbusTag.cpp
+ * Description  :     Latest value tag store of ModbusRTU point. Every decoded
+ *                    point (device map, planner, getter of driver) is
+ *                    published with sequence, timestamp and quality. Reader
+ *                    of any task/ core get a consistent copy without lock
+ *                    (seqlock of each tag)
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17 Oct 2026
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     089-140-7205
+ ***********************************************************************/
+
+#include "tiny32_ModbusTag.h"
+#include "Arduino.h"
+
+tiny32_ModbusTagStore modbus_tag;
+
+tiny32_ModbusTagStore::tiny32_ModbusTagStore(void) : _count(0)
+{
+  _enable = true;
+  _full = false;
+  memset(_tag, 0, sizeof(_tag));
+}
+
+/***********************************************************************
+ * FUNCTION:    enable
+ * DESCRIPTION: Start/ stop publish (bus only check one flag when stop),
+ *              store is enabled from start
+ * PARAMETERS:  enable
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusTagStore::enable(bool enable)
+{
+  _enable = enable;
+}
+
+/***********************************************************************
+ * FUNCTION:    clear
+ * DESCRIPTION: Remove all tag (index that reader keep is not valid after)
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusTagStore::clear(void)
+{
+  portENTER_CRITICAL(&_mux);
+  _count.store(0, std::memory_order_release);
+  _full = false;
+  portEXIT_CRITICAL(&_mux);
+}
+
+/***********************************************************************
+ * FUNCTION:    create
+ * DESCRIPTION: Append new tag (writer lock is taken by caller), key is
+ *              written before count is released to reader
+ * PARAMETERS:  bus, id, function, address, device, name
+ * RETURNED:    index, -1 = store is full
+ ***********************************************************************/
+int16_t tiny32_ModbusTagStore::create(uint8_t bus, uint8_t id, uint8_t function, uint16_t address, const char *device, const char *name)
+{
+  uint16_t _index = _count.load(std::memory_order_relaxed);
+
+  if (_index >= MODBUS_TAG_MAX)
+    return -1;
+
+  tiny32_ModbusTag *_t = &_tag[_index];
+  _t->bus = bus;
+  _t->id = id;
+  _t->function = function;
+  _t->address = address;
+  _t->device = device;
+  _t->name = name;
+  _t->value = 0;
+  _t->time_ms = 0;
+  _t->quality = MODBUS_QUALITY_NONE;
+  __atomic_store_n(&_t->sequence, 0, __ATOMIC_RELAXED);
+  _count.store(_index + 1, std::memory_order_release);
+  return _index;
+}
+
+/***********************************************************************
+ * FUNCTION:    write
+ * DESCRIPTION: Seqlock write of value part (writer lock is taken by
+ *              caller), bad value keep the last good value and time
+ * PARAMETERS:  tag, value, good, time_ms(millis() of the read)
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusTagStore::write(tiny32_ModbusTag *tag, float value, bool good, uint32_t time_ms)
+{
+  uint32_t _sequence = tag->sequence;
+
+  __atomic_store_n(&tag->sequence, _sequence + 1, __ATOMIC_RELAXED); // being written
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  if (good)
+  {
+    tag->value = value;
+    tag->time_ms = time_ms;
+    tag->quality = MODBUS_QUALITY_GOOD;
+  }
+  else if (tag->quality != MODBUS_QUALITY_NONE)
+    tag->quality = MODBUS_QUALITY_BAD;
+  __atomic_store_n(&tag->sequence, _sequence + 2, __ATOMIC_RELEASE);
+}
+
+/***********************************************************************
+ * FUNCTION:    add
+ * DESCRIPTION: Add tag before the first publish (get index for reader
+ *              early, give name to point of planner)
+ * PARAMETERS:  bus, id, function, address, device, name (static string)
+ * RETURNED:    index, -1 = store is full
+ ***********************************************************************/
+int16_t tiny32_ModbusTagStore::add(uint8_t bus, uint8_t id, uint8_t function, uint16_t address, const char *device, const char *name)
+{
+  int16_t _index;
+
+  portENTER_CRITICAL(&_mux);
+  _index = find(bus, id, function, address);
+  if (_index < 0)
+    _index = create(bus, id, function, address, device, name);
+  portEXIT_CRITICAL(&_mux);
+
+  if (_index < 0)
+    Serial.printf("Error: Tag store is full (%d tag)\r\n", MODBUS_TAG_MAX);
+  return _index;
+}
+
+/***********************************************************************
+ * FUNCTION:    find
+ * DESCRIPTION: Index of tag by key
+ * PARAMETERS:  bus, id, function, address
+ * RETURNED:    index, -1 = not found
+ ***********************************************************************/
+int16_t tiny32_ModbusTagStore::find(uint8_t bus, uint8_t id, uint8_t function, uint16_t address)
+{
+  uint16_t _count_now = count();
+
+  for (uint16_t _i = 0; _i < _count_now; _i++)
+  {
+    const tiny32_ModbusTag *_t = &_tag[_i];
+    if ((_t->address == address) && (_t->id == id) && (_t->bus == bus) && (_t->function == function))
+      return _i;
+  }
+
+  return -1;
+}
+
+/***********************************************************************
+ * FUNCTION:    find
+ * DESCRIPTION: Index of tag by device map name, register name and id
+ * PARAMETERS:  device (NULL = any), name, id
+ * RETURNED:    index, -1 = not found
+ ***********************************************************************/
+int16_t tiny32_ModbusTagStore::find(const char *device, const char *name, uint8_t id)
+{
+  uint16_t _count_now = count();
+
+  for (uint16_t _i = 0; _i < _count_now; _i++)
+  {
+    const tiny32_ModbusTag *_t = &_tag[_i];
+    if ((_t->id != id) || (_t->name == NULL) || (strcmp(_t->name, name) != 0))
+      continue;
+    if ((device == NULL) || ((_t->device != NULL) && (strcmp(_t->device, device) == 0)))
+      return _i;
+  }
+
+  return -1;
+}
+
+/***********************************************************************
+ * FUNCTION:    tag
+ * DESCRIPTION: Key of tag (bus, id, function, address, device, name), use
+ *              read for value
+ * PARAMETERS:  index
+ * RETURNED:    tag, NULL = out of the range
+ ***********************************************************************/
+const tiny32_ModbusTag *tiny32_ModbusTagStore::tag(uint16_t index)
+{
+  return (index < count()) ? &_tag[index] : NULL;
+}
+
+/***********************************************************************
+ * FUNCTION:    publish
+ * DESCRIPTION: Keep decoded value of one point (call from bus side after
+ *              each read). New tag is made by good value, bad value only
+ *              mark tag that is already there
+ * PARAMETERS:  bus, id, function, address, value, good, device, name
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusTagStore::publish(uint8_t bus, uint8_t id, uint8_t function, uint16_t address, float value, bool good, const char *device, const char *name)
+{
+  bool _full_now = false;
+
+  if (!_enable)
+    return;
+
+  portENTER_CRITICAL(&_mux);
+  int16_t _index = find(bus, id, function, address);
+  if ((_index < 0) && good)
+  {
+    _index = create(bus, id, function, address, device, name);
+    _full_now = (_index < 0) && !_full;
+    _full |= _full_now;
+  }
+  if (_index >= 0)
+    write(&_tag[_index], value, good, millis());
+  portEXIT_CRITICAL(&_mux);
+
+  if (_full_now)
+    Serial.printf("Error: Tag store is full (%d tag), new point is not kept\r\n", MODBUS_TAG_MAX);
+}
+
+/***********************************************************************
+ * FUNCTION:    publishSample
+ * DESCRIPTION: Keep good value that was decoded from a read at time_ms
+ *              (snapshot cache), value of the same read is kept once so
+ *              getter that is served from cache don't give a new sequence
+ * PARAMETERS:  bus, id, function, address, value, time_ms
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusTagStore::publishSample(uint8_t bus, uint8_t id, uint8_t function, uint16_t address, float value, uint32_t time_ms)
+{
+  bool _full_now = false;
+
+  if (!_enable)
+    return;
+
+  portENTER_CRITICAL(&_mux);
+  int16_t _index = find(bus, id, function, address);
+  if (_index < 0)
+  {
+    _index = create(bus, id, function, address, NULL, NULL);
+    _full_now = (_index < 0) && !_full;
+    _full |= _full_now;
+  }
+  if ((_index >= 0) && ((_tag[_index].quality == MODBUS_QUALITY_NONE) || ((int32_t)(time_ms - _tag[_index].time_ms) > 0)))
+    write(&_tag[_index], value, true, time_ms);
+  portEXIT_CRITICAL(&_mux);
+
+  if (_full_now)
+    Serial.printf("Error: Tag store is full (%d tag), new point is not kept\r\n", MODBUS_TAG_MAX);
+}
+
+/***********************************************************************
+ * FUNCTION:    read
+ * DESCRIPTION: Consistent copy of tag without lock (copy again when
+ *              writer was in the middle), good value older than
+ *              max_age_ms is MODBUS_QUALITY_STALE
+ * PARAMETERS:  index, value, max_age_ms (0 = no age check)
+ * RETURNED:    true = value is good, false = not good/ out of the range
+ ***********************************************************************/
+bool tiny32_ModbusTagStore::read(int16_t index, tiny32_ModbusTagValue *value, uint32_t max_age_ms)
+{
+  if ((index < 0) || (index >= count()))
+    return false;
+
+  const tiny32_ModbusTag *_t = &_tag[index];
+  uint32_t _sequence;
+
+  for (;;)
+  {
+    _sequence = __atomic_load_n(&_t->sequence, __ATOMIC_ACQUIRE);
+    if (_sequence & 1)
+      continue; // writer on the other core
+
+    value->value = _t->value;
+    value->time_ms = _t->time_ms;
+    value->quality = _t->quality;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&_t->sequence, __ATOMIC_RELAXED) == _sequence)
+      break;
+  }
+
+  value->sequence = _sequence / 2;
+  if ((value->quality == MODBUS_QUALITY_GOOD) && (max_age_ms > 0) && ((millis() - value->time_ms) > max_age_ms))
+    value->quality = MODBUS_QUALITY_STALE;
+
+  return value->quality == MODBUS_QUALITY_GOOD;
+}
+
+/***********************************************************************
+ * FUNCTION:    printTag
+ * DESCRIPTION: Print out all tag with value, quality and age
+ * PARAMETERS:  nothing
+ * RETURNED:    nothing
+ ***********************************************************************/
+void tiny32_ModbusTagStore::printTag(void)
+{
+  static const char *_quality[] = {"none", "good", "bad", "stale"};
+  tiny32_ModbusTagValue _v;
+  uint16_t _count_now = count();
+
+  Serial.printf("\r\nInfo: %d tag\r\n", _count_now);
+  Serial.printf("index  bus  id   function  address  quality  sequence  age(mS)  value        name\r\n");
+  for (uint16_t _i = 0; _i < _count_now; _i++)
+  {
+    const tiny32_ModbusTag *_t = &_tag[_i];
+
+    read(_i, &_v);
+    Serial.printf("%5d  %3d  %3d  0x%02X      0x%04X   %-7s  %8u  %7u  %-11g  %s%s%s\r\n", _i, _t->bus, _t->id, _t->function, _t->address,
+                  _quality[_v.quality], (unsigned)_v.sequence, (unsigned)((_v.quality == MODBUS_QUALITY_NONE) ? 0 : millis() - _v.time_ms), _v.value,
+                  (_t->device != NULL) ? _t->device : "", ((_t->device != NULL) && (_t->name != NULL)) ? "." : "", (_t->name != NULL) ? _t->name : "");
+  }
+}
@@ -0,0 +1,90 @@
+/***********************************************************************
+ * File         :     tiny32_ModbusTag.h
+ * Description  :     Latest value tag store of ModbusRTU point. Every decoded
+ *                    point (device map, planner, getter of driver, scheduler
+ *                    point with format) is published with sequence, timestamp
+ *                    and quality. Reader of any task/ core get a consistent
+ *                    copy without lock (seqlock of each tag)
+ * Author       :     Tenergy Innovation Co., Ltd.
+ * Date         :     17 Oct 2026
+ * Revision     :     1.0
+ * Rev1.0       :     Original
+ * website      :     http://www.tenergyinnovation.co.th
+ * Email        :     uten.boonliam@tenergyinnovation.co.th
+ * TEL          :     089-140-7205
+ ***********************************************************************/
+
+#ifndef TINY32_MODBUSTAG_H
+#define TINY32_MODBUSTAG_H
+#include <atomic>
+#include "Arduino.h"
+
+/**************************************/
+/*      ModbusRTU tag store define    */
+/**************************************/
+#define MODBUS_TAG_MAX 128 // maximum number of tag (bus + id + function + address)
+
+/**************************************/
+/*          tag quality define        */
+/**************************************/
+#define MODBUS_QUALITY_NONE 0  // never read
+#define MODBUS_QUALITY_GOOD 1  // value of the last read
+#define MODBUS_QUALITY_BAD 2   // the last read fail, value is the last good value
+#define MODBUS_QUALITY_STALE 3 // good value older than max age of reader
+
+/* consistent copy of one tag (read) */
+struct tiny32_ModbusTagValue
+{
+    float value;
+    uint32_t sequence; // number of publish, change = new value/ quality
+    uint32_t time_ms;  // millis() of the last good value
+    uint8_t quality;   // MODBUS_QUALITY_xxx
+};
+
+/* one tag, key is fixed after add, value part is written under seqlock */
+struct tiny32_ModbusTag
+{
+    uint8_t bus; // busId() of tiny32_ModbusMaster
+    uint8_t id;
+    uint8_t function;
+    uint16_t address;
+    const char *device; // static string (device map name) or NULL
+    const char *name;   // static string (register name) or NULL
+
+    uint32_t sequence; // seqlock, odd = being written
+    float value;
+    uint32_t time_ms;
+    uint8_t quality;
+};
+
+class tiny32_ModbusTagStore
+{
+public:
+    tiny32_ModbusTagStore(void);
+    void enable(bool enable);
+    bool enabled(void) { return _enable; }
+    void clear(void);
+
+    int16_t add(uint8_t bus, uint8_t id, uint8_t function, uint16_t address, const char *device = NULL, const char *name = NULL);
+    int16_t find(uint8_t bus, uint8_t id, uint8_t function, uint16_t address);
+    int16_t find(const char *device, const char *name, uint8_t id);
+    uint16_t count(void) { return _count.load(std::memory_order_acquire); }
+    const tiny32_ModbusTag *tag(uint16_t index);
+
+    void publish(uint8_t bus, uint8_t id, uint8_t function, uint16_t address, float value, bool good, const char *device = NULL, const char *name = NULL);
+    void publishSample(uint8_t bus, uint8_t id, uint8_t function, uint16_t address, float value, uint32_t time_ms);
+    bool read(int16_t index, tiny32_ModbusTagValue *value, uint32_t max_age_ms = 0);
+    void printTag(void);
+
+private:
+    tiny32_ModbusTag _tag[MODBUS_TAG_MAX];
+    std::atomic<uint16_t> _count; // tag [0, _count) are ready to read
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED; // writer only (add/ publish)
+    volatile bool _enable;
+    bool _full; // error of full store was printed
+    int16_t create(uint8_t bus, uint8_t id, uint8_t function, uint16_t address, const char *device, const char *name);
+    void write(tiny32_ModbusTag *tag, float value, bool good, uint32_t time_ms);
+};
+
+extern tiny32_ModbusTagStore modbus_tag;
+#endif
@@ -36,6 +36,31 @@
  * Rev3.11      :     Add EASTRON Powermeter 3-phase model :SDM630MCT
  * Rev3.12      :     Add Chiller_R717 ModbusRTU [27-04-2024]
  * Rev3.13      :     Add Inverter ATESS ModbusRUT [28-04-2024]
+ * Rev3.14      :     Replace fixed 300mS response delay with length-aware, t3.5 silence-terminated receive
+ * Rev3.15      :     Move ModbusRTU request/response/decode to tiny32_ModbusMaster engine
+ * Rev3.16      :     Table driven CRC16 (build at compile time) and cache CRC16 of repeated request
+ * Rev3.17      :     Asynchronous ModbusRTU master, request queue served by bus task (modbusRTU_beginTask)
+ * Rev3.18      :     rs485_2 move to UART2, RXD2/TXD2 and RXD3/TXD3 are 2 independent bus with own bus task
+ * Rev3.19      :     Add tiny32_ModbusScheduler, poll point with own period by earliest deadline first
+ * Rev3.20      :     Add tiny32_ModbusPlanner, merge near register of requested point into one block read
+ * Rev3.21      :     Fast SearchAddress with adaptive probe timeout, modbusRTU_discover list all device on the bus
+ * Rev3.22      :     Snapshot cache (modbusRTU_setCacheTTL) for PZEM-016, PZEM-003, WTR10-E, XY-MD02, PR-3000 getters
+ * Rev3.23      :     ModbusRTU fail fast on exception/ other id response, lastError/ lastException reason
+ * Rev3.24      :     ModbusRTU adaptive timeout, learn answer time of each device (modbusRTU_setAdaptiveTimeout)
+ * Rev3.25      :     ModbusRTU metrics of bus and device, modbusRTU_metricsJSON
+ * Rev3.26      :     ModbusRTU runtime frame capture (modbus_capture), extra/modbus_capture.py converter
+ * Rev3.27      :     ModbusRTU response resync with CRC16 sliding window, noise before/after frame is skipped
+ * Rev3.28      :     ModbusRTU bus mutex (priority inheritance), thread safe without bus task, contention metrics
+ * Rev3.29      :     ModbusRTU priority lane, write/ on demand read go before queued poll (bounded write latency)
+ * Rev3.30      :     ModbusRTU line setting of each device (modbusRTU_setDeviceLine), switch UART only when needed
+ * Rev3.31      :     tiny32_ModbusRTU_read any start address and count (up to 62 float in one frame)
+ * Rev3.32      :     Compile time register decoder (tiny32_ModbusDecode.h) for all word order and scale
+ * Rev3.33      :     Declarative device register map (tiny32_ModbusMap), CHILLER_R717 and ATESS getter use the map
+ * Rev3.34      :     SDM630MCT_read snapshot of all 3-phase value in one FC04 request, getters use the last snapshot
+ * Rev3.35      :     SchneiderPM2xxx_read snapshot of metering value in 2 request with field mask, getters use the last snapshot
+ * Rev3.36      :     CHILLER_R717_read (3 request) and ATESS_read (1 request) snapshot, getters use the last snapshot
+ * Rev3.37      :     ENenergic_readState full state (phasor) in 2 request
+ * Rev3.38      :     Lock free latest value tag store (modbus_tag), device map/ planner read publish every point
  * website      :     http://www.tenergyinnovation.co.th
  * Email        :     uten.boonliam@tenergyinnovation.co.th
  * TEL          :     089-140-7205
@@ -43,14 +68,26 @@
 
 #ifndef TINY32_H
 #define TINY32_H
+#include "Arduino.h"
 #include "Ticker.h"
+#include "tiny32_ModbusMaster.h"
+#include "tiny32_ModbusScheduler.h"
+#include "tiny32_ModbusPlanner.h"
+#include "tiny32_ModbusDeviceMap.h"
+#include "tiny32_ModbusTag.h"
 
 class tiny32_v3
 {
 private:
-#define version_c "3.13"
+#define version_c "3.38"
 
 public:
+/**************************************/
+/*        ModbusRTU define            */
+/**************************************/
+#define MODBUS_DISCOVERY_MAX 32                         // maximum device for modbusRTU_discover
+#define TINY32_MODBUSRTU_FLOAT_MAX (MODBUS_REGISTER_MAX / 2) // maximum float for one tiny32_ModbusRTU_read (62)
+
 /**************************************/
 /*           GPIO define              */
 /**************************************/
@@ -81,7 +118,35 @@ public:
 
 private:
     uint8_t _resolution_bit;
-    uint16_t crc16_update(uint16_t crc, uint8_t a);
+    float modbusRTU_readFloat(tiny32_ModbusMaster &bus, uint8_t id, uint8_t function, uint16_t address);
+    template <typename DECODER>
+    float modbusRTU_readValue(tiny32_ModbusMaster &bus, uint8_t id, uint8_t function, uint16_t address, uint16_t quantity, uint16_t offset, bool snapshot = true);
+    void modbusRTU_publish(tiny32_ModbusMaster &bus, uint8_t id, uint8_t function, const uint16_t *address, const float *value, uint8_t count, uint32_t time_ms = 0);
+    tiny32_ModbusMaster *modbusRTU_bus(uint8_t rx);
+
+    /* RS485 bus and line setting of each ModbusRTU driver (bus is selected by rx pin of _begin) */
+    tiny32_ModbusDriver _bus_ec_modbusRTU;
+    tiny32_ModbusDriver _bus_PZEM_016;
+    tiny32_ModbusDriver _bus_PZEM_003;
+    tiny32_ModbusDriver _bus_WTR10_E;
+    tiny32_ModbusDriver _bus_XY_MD02;
+    tiny32_ModbusDriver _bus_PR3000_H_N01;
+    tiny32_ModbusDriver _bus_WATER_FLOW_METER;
+    tiny32_ModbusDriver _bus_PYR20;
+    tiny32_ModbusDriver _bus_tiny32_ModbusRTU;
+    tiny32_ModbusDriver _bus_ENenergic;
+    tiny32_ModbusDriver _bus_SchneiderPM2xxx;
+    tiny32_ModbusDriver _bus_SDM120CT;
+    tiny32_ModbusDriver _bus_tiny32_WIND_RSFSN01;
+    tiny32_ModbusDriver _bus_SDM630MCT;
+    tiny32_ModbusDriver _bus_CHILLER_R717;
+    tiny32_ModbusDriver _bus_ATESS;
+    tiny32_ModbusSnapshotStore<tiny32_SDM630MCT> _SDM630MCT_snapshot; // copy of SDM630MCT_read of each id (getter use it within cache TTL)
+    tiny32_ModbusSnapshotStore<tiny32_SchneiderPM2xxx> _SchneiderPM2xxx_snapshot; // copy of SchneiderPM2xxx_read of each id
+    tiny32_ModbusSnapshotStore<tiny32_CHILLER_R717> _CHILLER_R717_snapshot; // copy of CHILLER_R717_read of each id
+    tiny32_ModbusSnapshotStore<tiny32_ATESS> _ATESS_snapshot; // copy of ATESS_read of each id
+    tiny32_ModbusSnapshotStore<tiny32_ENenergic> _ENenergic_snapshot; // register copy of ENenergic_readState of each id
+    int8_t modbusRTU_setAddress(tiny32_ModbusMaster &bus, uint8_t id, uint16_t address, uint8_t new_id);
 
 public:
     void TickBlueLED(float second);
@@ -93,6 +158,14 @@ public:
     uint16_t TimeStamp_minute_encode(uint16_t y, uint8_t m, uint8_t d, uint8_t h, uint8_t mi);
     uint16_t TimeStamp_24hr_encode(uint16_t h, uint16_t mi);
     void TimeStamp_hour_minute_decode(uint16_t timestemp, uint16_t &h, uint16_t &mi);
+    void modbusRTU_setTimeout(uint16_t timeout_ms);
+    uint16_t modbusRTU_getTimeout(void);
+    bool modbusRTU_setDeviceLine(uint8_t id, uint32_t baud, uint32_t config = SERIAL_8N1, uint8_t rx = RXD2);
+    uint16_t modbusRTU_metricsJSON(char *json, uint16_t size);
+    void modbusRTU_setAdaptiveTimeout(bool enable, uint16_t floor_ms = MODBUS_TIMEOUT_FLOOR, uint16_t ceiling_ms = MODBUS_TIMEOUT_CEILING);
+    void modbusRTU_setCacheTTL(uint16_t ttl_ms);
+    bool modbusRTU_beginTask(UBaseType_t priority = 2, BaseType_t core = 0);
+    uint8_t modbusRTU_discover(uint8_t rx = RXD2, uint8_t first = 1, uint8_t last = 247);
 
 private:
     uint16_t ec_modbusRTU(uint8_t id);
@@ -159,6 +232,7 @@ public:
     bool tiny32_ModbusRTU_begin(uint8_t rx = RXD2, uint8_t tx = TXD2);
     int8_t tiny32_ModbusRTU_searchAddress(void);
     int8_t tiny32_ModbusRTU_setAddress(uint8_t id, uint8_t new_id);
+    bool tiny32_ModbusRTU_read(uint8_t id, uint16_t address, float *val, uint8_t count);
     bool tiny32_ModbusRTU(uint8_t id, float &val1, float &val2, float &val3, float &val4, float &val5, float &val6, float &val7, float &val8, float &val9, float &val10);
     bool tiny32_ModbusRTU(uint8_t id, float &val1, float &val2, float &val3, float &val4, float &val5, float &val6, float &val7, float &val8, float &val9);
     bool tiny32_ModbusRTU(uint8_t id, float &val1, float &val2, float &val3, float &val4, float &val5, float &val6, float &val7, float &val8);
@@ -174,6 +248,7 @@ public:
     bool ENenergic_begin(uint8_t rx = RXD2, uint8_t tx = TXD2);
     int8_t ENenergic_searchAddress(void);
     int8_t ENenergic_setAddress(uint8_t id, uint8_t new_id);
+    bool ENenergic_readState(uint8_t id, tiny32_ENenergicState &state); // 2 request [ID 03 00 00 00 1A ], [ID 03 00 6A 00 18 ]
     float ENenergic_getTemperature(uint8_t id);
     bool ENenergic_Volt_L_N(uint8_t id, float &L1_N, float &L2_N, float &L3_N);
     bool ENenergic_Volt_L_L(uint8_t id, float &L1_L2, float &L2_L3, float &L3_L1);
@@ -186,6 +261,7 @@ public:
     /* Schneider EasyLogic PM2xxx Digital Power Meter */
     bool SchneiderPM2xxx_begin(uint8_t rx = RXD2, uint8_t tx = TXD2);
     int8_t SchneiderPM2xxx_searchAddress(void);
+    bool SchneiderPM2xxx_read(uint8_t id, tiny32_SchneiderPM2xxx &snapshot, uint64_t mask = MODBUS_FIELD_ALL); // 3000 - 3085 and 3110 in 2 request [ID 03 0B B7 00 56 ]
 
     bool SchneiderPM2xxx_MeteringSetup(void);
 
@@ -259,6 +335,7 @@ public:
     /* EASTRON SDM630MCT Modbus 3-Phase Powermeter */
     bool SDM630MCT_begin(uint8_t rx = RXD2, uint8_t tx = TXD2);
     int8_t SDM630MCT_searchAddress(void);
+    bool SDM630MCT_read(uint8_t id, tiny32_SDM630MCT &snapshot); // 30000 - 30071 in one request [ID 04 00 00 00 48 ]
 
     float SDM630MCT_P1_Volt(uint8_t id); // 30000 - 30001 [ID 04 00 00 00 02 ]
     float SDM630MCT_P2_Volt(uint8_t id); // 30002 - 30003 [ID 04 00 02 00 02 ]
@@ -293,6 +370,7 @@ public:
 
     /* Chiller R717 ModbusRTU for Read sensor */
     bool CHILLER_R717_begin(uint8_t rx = RXD2, uint8_t tx = TXD2);
+    bool CHILLER_R717_read(uint8_t id, tiny32_CHILLER_R717 &snapshot, uint64_t mask = MODBUS_FIELD_ALL); // 3 request [0x0001-0x0033, 0x009D-0x00A0, 0x0144-0x0147]
 
     float CHILLER_R717_AI01_CHILLED_IN(uint8_t id);
     float CHILLER_R717_AI02_CHILLED_OUT(uint8_t id);
@@ -326,6 +404,7 @@ public:
 
     /* Inverter ATESS ModbusRTU for Read parameter */
     bool ATESS_R717_begin(uint8_t rx = RXD2, uint8_t tx = TXD2);
+    bool ATESS_read(uint8_t id, tiny32_ATESS &snapshot, uint64_t mask = MODBUS_FIELD_ALL); // 1 request [ID 04 00 11 00 4E ]
     
     float ATESS_Power_PV_kW(uint8_t id);
     float ATESS_Power_bat_kW(uint8_t id);